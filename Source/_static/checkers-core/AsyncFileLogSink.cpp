@@ -0,0 +1,296 @@
+//---------------------------------------------------------------
+//
+// AsyncFileLogSink.cpp
+//
+
+#include "AsyncFileLogSink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include <spdlog/pattern_formatter.h>
+
+namespace Checkers {
+
+//===============================================================
+
+AsyncFileLogSink::AsyncFileLogSink(const std::string& filePath, size_t maxFileBytes, int32_t maxFileCount)
+	: m_filePath(filePath)
+	, m_maxFileBytes(maxFileBytes)
+	, m_maxFileCount(std::max(maxFileCount, 1))
+	, m_records(std::make_unique<LogRecord[]>(LogSettings::s_ringBufferCapacity))
+	, m_formatter(std::make_unique<spdlog::pattern_formatter>())
+{
+	for (size_t slotIndex = 0; slotIndex < LogSettings::s_ringBufferCapacity; ++slotIndex)
+	{
+		m_records[slotIndex].sequence.store(slotIndex, std::memory_order_relaxed);
+	}
+	m_batch.reserve(LogSettings::s_writeBatchBytes + LogSettings::s_maxRecordPayloadLength * 2);
+}
+
+AsyncFileLogSink::~AsyncFileLogSink()
+{
+	if (m_writerThread.joinable())
+	{
+		{
+			std::scoped_lock lock(m_writerMutex);
+			m_isShuttingDown = true;
+		}
+		m_writerWakeCondition.notify_one();
+		m_writerThread.join();
+	}
+
+	if (m_file)
+	{
+		std::fclose(m_file);
+	}
+}
+
+bool AsyncFileLogSink::Initialize()
+{
+	const std::filesystem::path path(m_filePath);
+	std::error_code error;
+	if (path.has_parent_path())
+	{
+		std::filesystem::create_directories(path.parent_path(), error);
+	}
+
+	m_file = std::fopen(m_filePath.c_str(), "ab");
+	if (!m_file)
+	{
+		return false;
+	}
+
+	// Batches are already big, let every one go straight to the file as a single write.
+	std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+	const uintmax_t existingBytes = std::filesystem::file_size(path, error);
+	m_fileBytes = error ? 0 : static_cast<size_t>(existingBytes);
+
+	m_writerThread = std::thread(&AsyncFileLogSink::WriterLoop, this);
+	return true;
+}
+
+void AsyncFileLogSink::log(const spdlog::details::log_msg& msg)
+{
+	// Claim a slot. The sequence number lags the position by a whole lap while the writer still owns the slot, which
+	// means the buffer is full.
+	uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+	LogRecord* record = nullptr;
+	while (true)
+	{
+		record = &m_records[position & s_ringBufferMask];
+		const uint64_t sequence = record->sequence.load(std::memory_order_acquire);
+		const int64_t lag = static_cast<int64_t>(sequence - position);
+		if (lag == 0)
+		{
+			if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (lag < 0)
+		{
+			m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+			m_totalDroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else
+		{
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	record->time = msg.time;
+	record->threadId = msg.thread_id;
+	record->level = msg.level;
+
+	record->loggerNameLength = static_cast<uint8_t>(std::min(msg.logger_name.size(), s_maxLoggerNameLength));
+	std::memcpy(record->loggerName.data(), msg.logger_name.data(), record->loggerNameLength);
+
+	record->payloadLength = static_cast<uint16_t>(std::min(msg.payload.size(), LogSettings::s_maxRecordPayloadLength));
+	std::memcpy(record->payload.data(), msg.payload.data(), record->payloadLength);
+
+	record->sequence.store(position + 1, std::memory_order_release);
+}
+
+void AsyncFileLogSink::flush()
+{
+	std::unique_lock lock(m_writerMutex);
+	if (!m_writerThread.joinable() || m_isShuttingDown)
+	{
+		return;
+	}
+
+	const uint64_t flushId = ++m_requestedFlushId;
+	m_writerWakeCondition.notify_one();
+	m_flushCompletedCondition.wait(lock, [this, flushId]()
+	{
+		return m_completedFlushId >= flushId;
+	});
+}
+
+void AsyncFileLogSink::set_pattern(const std::string& pattern)
+{
+	set_formatter(std::make_unique<spdlog::pattern_formatter>(pattern));
+}
+
+void AsyncFileLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter)
+{
+	std::scoped_lock lock(m_formatterMutex);
+	m_formatter = std::move(sinkFormatter);
+}
+
+void AsyncFileLogSink::WriterLoop()
+{
+	while (true)
+	{
+		uint64_t flushId = 0;
+		bool isShuttingDown = false;
+		{
+			std::scoped_lock lock(m_writerMutex);
+			flushId = m_requestedFlushId;
+			isShuttingDown = m_isShuttingDown;
+		}
+
+		// Anything logged before the flush or shutdown was asked for is in the buffer by now.
+		const bool wasAnythingDrained = DrainRecords();
+		WriteBatch();
+
+		std::unique_lock lock(m_writerMutex);
+		if (m_completedFlushId != flushId)
+		{
+			m_completedFlushId = flushId;
+			m_flushCompletedCondition.notify_all();
+		}
+
+		if (isShuttingDown)
+		{
+			return;
+		}
+
+		// Only sleep when idle. While records keep coming, go straight back for more so the buffer doesn't fill up.
+		if (wasAnythingDrained)
+		{
+			continue;
+		}
+
+		m_writerWakeCondition.wait_for(lock, std::chrono::milliseconds{ LogSettings::s_writerIdleMilliseconds }, [this, flushId]()
+		{
+			return m_isShuttingDown || m_requestedFlushId != flushId;
+		});
+	}
+}
+
+bool AsyncFileLogSink::DrainRecords()
+{
+	std::scoped_lock lock(m_formatterMutex);
+	const uint64_t startPosition = m_dequeuePosition;
+	while (true)
+	{
+		LogRecord& record = m_records[m_dequeuePosition & s_ringBufferMask];
+		if (record.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+		{
+			break;
+		}
+
+		spdlog::details::log_msg msg(record.time, spdlog::source_loc{},
+			spdlog::string_view_t(record.loggerName.data(), record.loggerNameLength), record.level,
+			spdlog::string_view_t(record.payload.data(), record.payloadLength));
+		msg.thread_id = record.threadId;
+		FormatIntoBatch(msg);
+
+		// Hand the slot back to the producers for their next lap around the buffer.
+		record.sequence.store(m_dequeuePosition + LogSettings::s_ringBufferCapacity, std::memory_order_release);
+		++m_dequeuePosition;
+
+		if (m_batch.size() >= LogSettings::s_writeBatchBytes)
+		{
+			WriteBatch();
+		}
+	}
+
+	// Report drops after the records that made it, so the note lands about where the gap is.
+	const uint64_t droppedCount = m_droppedCount.exchange(0, std::memory_order_relaxed);
+	if (droppedCount > 0)
+	{
+		const std::string text = fmt::format("Log records dropped, the ring buffer was full. count={}", droppedCount);
+		const spdlog::details::log_msg msg(spdlog::string_view_t{}, spdlog::level::warn, text);
+		FormatIntoBatch(msg);
+	}
+
+	return m_dequeuePosition != startPosition;
+}
+
+void AsyncFileLogSink::FormatIntoBatch(const spdlog::details::log_msg& msg)
+{
+	if (m_formatter)
+	{
+		m_formatter->format(msg, m_batch);
+	}
+}
+
+void AsyncFileLogSink::WriteBatch()
+{
+	if (m_batch.size() == 0 || !m_file)
+	{
+		return;
+	}
+
+	if (m_fileBytes > 0 && m_fileBytes + m_batch.size() > m_maxFileBytes)
+	{
+		RotateFiles();
+		if (!m_file)
+		{
+			m_batch.clear();
+			return;
+		}
+	}
+
+	m_fileBytes += std::fwrite(m_batch.data(), 1, m_batch.size(), m_file);
+	m_batch.clear();
+}
+
+void AsyncFileLogSink::RotateFiles()
+{
+	std::fclose(m_file);
+
+	// The oldest file falls off the end.
+	std::error_code error;
+	for (int32_t index = m_maxFileCount - 1; index > 0; --index)
+	{
+		const std::string sourcePath = GetRotatedFilePath(index - 1);
+		if (std::filesystem::exists(sourcePath, error))
+		{
+			std::filesystem::rename(sourcePath, GetRotatedFilePath(index), error);
+		}
+	}
+
+	// With only one file allowed, it just starts over.
+	m_file = std::fopen(m_filePath.c_str(), "wb");
+	if (m_file)
+	{
+		std::setvbuf(m_file, nullptr, _IONBF, 0);
+	}
+	m_fileBytes = 0;
+}
+
+std::string AsyncFileLogSink::GetRotatedFilePath(int32_t index) const
+{
+	if (index == 0)
+	{
+		return m_filePath;
+	}
+
+	std::filesystem::path path(m_filePath);
+	const std::string extension = path.extension().string();
+	path.replace_extension();
+	return fmt::format("{}.{}{}", path.string(), index, extension);
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------
+//
+// AsyncFileLogSink.h
+//
+
+#pragma once
+
+#include "GameSettings.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <spdlog/sinks/sink.h>
+
+namespace Checkers {
+
+//===============================================================
+
+// A log sink that never does I/O on the thread that logs. Records are copied into a fixed size lock-free ring buffer
+// and a background writer thread formats them and writes them to a rotating file in large batches.
+//
+// Logging never blocks and never allocates. If the writer falls behind and the ring buffer fills up, new records are
+// dropped and counted, and the writer notes how many were lost in the file once it catches up. Whatever is in the
+// buffer is written out on flush() and when the sink is destroyed.
+class AsyncFileLogSink final : public spdlog::sinks::sink
+{
+public:
+	AsyncFileLogSink(const AsyncFileLogSink& other) = delete;
+	AsyncFileLogSink& operator=(const AsyncFileLogSink& other) = delete;
+	AsyncFileLogSink(AsyncFileLogSink&& other) noexcept = delete;
+	AsyncFileLogSink& operator=(AsyncFileLogSink&& other) noexcept = delete;
+
+	AsyncFileLogSink(const std::string& filePath, size_t maxFileBytes, int32_t maxFileCount);
+	~AsyncFileLogSink() override;
+
+	// Opens the log file and starts the writer thread. Returns false if the file can't be opened.
+	bool Initialize();
+
+	// Copies the record into the ring buffer, or drops it if the buffer is full.
+	void log(const spdlog::details::log_msg& msg) override;
+
+	// Blocks until everything logged before the call has been written to the file.
+	void flush() override;
+
+	void set_pattern(const std::string& pattern) override;
+	void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+	// Records dropped because the ring buffer was full, since the sink was created.
+	uint64_t GetDroppedRecordCount() const { return m_totalDroppedCount.load(std::memory_order_relaxed); }
+
+private:
+
+	static constexpr size_t s_ringBufferMask = LogSettings::s_ringBufferCapacity - 1;
+	static_assert((LogSettings::s_ringBufferCapacity & s_ringBufferMask) == 0, "The ring buffer capacity must be a power of two.");
+
+	// Logger names longer than this are cut off.
+	static constexpr size_t s_maxLoggerNameLength = 31;
+
+	// One slot of the ring buffer. The sequence number says whose turn it is: a producer may fill the slot when it
+	// equals the producer's position, and the writer may read it when it equals the writer's position plus one.
+	struct LogRecord
+	{
+		std::atomic<uint64_t> sequence = 0;
+
+		spdlog::log_clock::time_point time;
+		size_t threadId = 0;
+		spdlog::level::level_enum level = spdlog::level::off;
+
+		uint8_t loggerNameLength = 0;
+		std::array<char, s_maxLoggerNameLength> loggerName;
+
+		uint16_t payloadLength = 0;
+		std::array<char, LogSettings::s_maxRecordPayloadLength> payload;
+	};
+
+	// Drains the ring buffer into the file until the sink is destroyed.
+	void WriterLoop();
+
+	// Formats every record in the ring buffer into the batch, writing the batch out whenever it gets big enough.
+	// Returns whether there were any records.
+	bool DrainRecords();
+
+	// Formats one record onto the end of the batch.
+	void FormatIntoBatch(const spdlog::details::log_msg& msg);
+
+	// Writes the batch to the file in one go, rotating first if the file would grow too big.
+	void WriteBatch();
+
+	// Closes the file, shifts every older file up a number, and starts a new one.
+	void RotateFiles();
+
+	// The path of the index-th file. The 0th is the one being written to.
+	std::string GetRotatedFilePath(int32_t index) const;
+
+	const std::string m_filePath;
+	const size_t m_maxFileBytes;
+	const int32_t m_maxFileCount;
+
+	std::unique_ptr<LogRecord[]> m_records;
+
+	// Next slot a producer will claim. Producers race on this with compare-exchange.
+	alignas(64) std::atomic<uint64_t> m_enqueuePosition = 0;
+
+	// Next slot the writer will read. Only the writer thread touches it.
+	alignas(64) uint64_t m_dequeuePosition = 0;
+
+	// Dropped since the writer last reported it, and in total.
+	std::atomic<uint64_t> m_droppedCount = 0;
+	std::atomic<uint64_t> m_totalDroppedCount = 0;
+
+	// Only the writer formats, but the pattern can be changed from any thread.
+	std::mutex m_formatterMutex;
+	std::unique_ptr<spdlog::formatter> m_formatter;
+
+	// Formatted records waiting to be written. Only the writer thread touches these.
+	spdlog::memory_buf_t m_batch;
+	std::FILE* m_file = nullptr;
+	size_t m_fileBytes = 0;
+
+	// Guards the flush and shutdown requests below. Logging never takes it.
+	std::mutex m_writerMutex;
+	std::condition_variable m_writerWakeCondition;
+	std::condition_variable m_flushCompletedCondition;
+	uint64_t m_requestedFlushId = 0;
+	uint64_t m_completedFlushId = 0;
+	bool m_isShuttingDown = false;
+
+	std::thread m_writerThread;
+};
+
+//===============================================================
+
+}
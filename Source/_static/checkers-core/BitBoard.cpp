@@ -0,0 +1,56 @@
+//---------------------------------------------------------------
+//
+// BitBoard.cpp
+//
+
+#include "BitBoard.h"
+
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+namespace Checkers {
+
+//===============================================================
+
+template <typename Geometry>
+BasicBitBoard<Geometry> BasicBitBoard<Geometry>::FromGameBoard(std::span<const Piece> gameBoard)
+{
+	BasicBitBoard board;
+	for (int32_t index = 0; index < static_cast<int32_t>(gameBoard.size()); ++index)
+	{
+		const int32_t square = Geometry::ToSquareFromGameBoardIndex(index);
+		if (square == GameBoardStatics::s_invalidSquare)
+		{
+#ifdef DEBUG
+			// Pieces can't live on light squares. If you're here, a test board was set up wrong.
+			assert(gameBoard[index].identity == Identity::Neutral);
+#endif
+			continue;
+		}
+
+		board.SetPieceAtSquare(square, gameBoard[index]);
+	}
+
+	return board;
+}
+
+template <typename Geometry>
+std::vector<Piece> BasicBitBoard<Geometry>::ToGameBoard() const
+{
+	std::vector<Piece> gameBoard(Geometry::s_gameSquareCount, GameBoardStatics::s_emptyPiece);
+
+	for (int32_t square = 0; square < Geometry::s_playableSquareCount; ++square)
+	{
+		gameBoard[Geometry::ToGameBoardIndexFromSquare(square)] = GetPieceAtSquare(square);
+	}
+
+	return gameBoard;
+}
+
+template struct BasicBitBoard<BoardGeometry<8>>;
+template struct BasicBitBoard<BoardGeometry<10>>;
+
+//===============================================================
+
+}
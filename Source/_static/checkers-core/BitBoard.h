@@ -0,0 +1,245 @@
+//---------------------------------------------------------------
+//
+// BitBoard.h
+//
+
+#pragma once
+
+#include "BoardGeometry.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+// Only the dark squares of the board can ever hold a piece, so the board is stored as bit masks over those squares,
+// one bit per square. Squares are numbered in reading order from the top left, which is checkers notation minus one.
+// On 8x8:
+//   row 0: squares 0-3 sit on columns 1, 3, 5, 7
+//   row 1: squares 4-7 sit on columns 0, 2, 4, 6
+//   ...and so on, alternating.
+// The geometry is a template parameter so other board sizes get their own fully constant folded copy. The game
+// itself plays on BitBoard, the 8x8 one, which fits in 32 bits.
+template <typename Geometry>
+struct BasicBitBoard
+{
+	using SquareMask = typename Geometry::SquareMask;
+
+	// Each row holds this many playable squares.
+	static constexpr int32_t s_squaresPerRow = Geometry::s_squaresPerRow;
+
+	// Every playable square.
+	static constexpr SquareMask s_allSquaresMask = Geometry::s_allSquaresMask;
+
+	// Squares on even rows (0, 2, ...). Their dark squares are on odd columns.
+	static constexpr SquareMask s_evenRowsMask = []
+	{
+		SquareMask mask = 0;
+		for (int32_t row = 0; row < Geometry::s_boardSize; row += 2)
+		{
+			mask |= Geometry::GetRowMask(row);
+		}
+		return mask;
+	}();
+
+	// Squares on odd rows (1, 3, ...). Their dark squares are on even columns.
+	static constexpr SquareMask s_oddRowsMask = s_allSquaresMask & ~s_evenRowsMask;
+
+	// The squares of row 0. Shift by row * s_squaresPerRow for any other row.
+	static constexpr SquareMask s_firstRowMask = Geometry::GetRowMask(0);
+
+	// Squares on the first column, nothing exists to their left. They start the odd rows.
+	static constexpr SquareMask s_leftEdgeMask = []
+	{
+		SquareMask mask = 0;
+		for (int32_t row = 1; row < Geometry::s_boardSize; row += 2)
+		{
+			mask |= Geometry::GetSquareMask(row * s_squaresPerRow);
+		}
+		return mask;
+	}();
+
+	// Squares on the last column, nothing exists to their right. They end the even rows.
+	static constexpr SquareMask s_rightEdgeMask = s_leftEdgeMask >> 1;
+
+	// Every square holding a red piece, pawn or king.
+	SquareMask red = 0;
+
+	// Every square holding a black piece, pawn or king.
+	SquareMask black = 0;
+
+	// Every square holding a king, of either color.
+	SquareMask kings = 0;
+
+	bool operator==(const BasicBitBoard& other) const = default;
+
+	// Returns a mask with only the given square set.
+	static constexpr SquareMask GetSquareMask(int32_t square) { return Geometry::GetSquareMask(square); }
+
+	// Returns the row a pawn of the given player gets promoted on.
+	static constexpr SquareMask GetKingRowMask(Identity id)
+	{
+		return Geometry::GetRowMask(id == Identity::Red ? Geometry::s_redKingRowIndex : Geometry::s_blackKingRowIndex);
+	}
+
+	// Returns every square holding a piece of either color.
+	SquareMask GetOccupied() const { return red | black; }
+
+	// Returns every playable square that has nothing on it.
+	SquareMask GetEmpty() const { return ~GetOccupied() & s_allSquaresMask; }
+
+	// Returns every square holding a piece owned by the given player.
+	SquareMask GetPiecesForId(Identity id) const
+	{
+		return id == Identity::Red ? red : (id == Identity::Black ? black : 0);
+	}
+
+	// Returns every square holding a piece owned by the given player's opponent.
+	SquareMask GetOpponentPiecesForId(Identity id) const
+	{
+		return id == Identity::Red ? black : (id == Identity::Black ? red : 0);
+	}
+
+	// Returns how many pieces the given player has left on the board.
+	int32_t GetPiecesCount(Identity id) const { return std::popcount(GetPiecesForId(id)); }
+
+	// Builds the Piece at the given square from the masks.
+	Piece GetPieceAtSquare(int32_t square) const
+	{
+		const SquareMask squareMask = GetSquareMask(square);
+		const PieceType pieceType = (kings & squareMask) ? PieceType::King : PieceType::Pawn;
+		if (red & squareMask)
+		{
+			return { pieceType, Identity::Red };
+		}
+		if (black & squareMask)
+		{
+			return { pieceType, Identity::Black };
+		}
+		return GameBoardStatics::s_emptyPiece;
+	}
+
+	// Clears the square, then places the given piece on it. An empty piece simply clears the square.
+	void SetPieceAtSquare(int32_t square, const Piece& piece)
+	{
+		const SquareMask squareMask = GetSquareMask(square);
+		red &= ~squareMask;
+		black &= ~squareMask;
+		kings &= ~squareMask;
+
+		if (piece.identity == Identity::Red)
+		{
+			red |= squareMask;
+		}
+		else if (piece.identity == Identity::Black)
+		{
+			black |= squareMask;
+		}
+
+		if (piece.pieceType == PieceType::King && piece.identity != Identity::Neutral)
+		{
+			kings |= squareMask;
+		}
+	}
+
+	// Plays a whole turn on the masks: the piece on sourceSquare ends up on destSquare, and every piece on
+	// capturedSquares is taken. A pawn that ends on its king row is crowned. Returns true if it was.
+	bool ApplyMove(int32_t sourceSquare, int32_t destSquare, SquareMask capturedSquares)
+	{
+		const SquareMask sourceMask = GetSquareMask(sourceSquare);
+		const SquareMask destMask = GetSquareMask(destSquare);
+		const bool isRed = (red & sourceMask) != 0;
+		const bool wasKing = (kings & sourceMask) != 0;
+		const bool isPromoted = !wasKing && (destMask & GetKingRowMask(isRed ? Identity::Red : Identity::Black));
+
+		SquareMask& ownPieces = isRed ? red : black;
+		SquareMask& opponentPieces = isRed ? black : red;
+
+		// A king's capture chain can end back where it started, so clear the source before setting the dest.
+		ownPieces = (ownPieces & ~sourceMask) | destMask;
+		opponentPieces &= ~capturedSquares;
+		kings &= ~(capturedSquares | sourceMask);
+		if (wasKing || isPromoted)
+		{
+			kings |= destMask;
+		}
+		return isPromoted;
+	}
+
+	// Shift based stepping. Each of these moves every square in the mask one diagonal step in its direction, and
+	// drops any square that would step off the board. Going up, even rows shift by a row's worth of squares or one
+	// less, odd rows by a row's worth or one more, because of how the dark squares alternate columns (see the layout
+	// above). Going down is the mirror of that.
+	static constexpr SquareMask StepUpLeft(SquareMask mask)
+	{
+		return ((mask & s_evenRowsMask) >> s_squaresPerRow) |
+			((mask & s_oddRowsMask & ~s_leftEdgeMask) >> (s_squaresPerRow + 1));
+	}
+
+	static constexpr SquareMask StepUpRight(SquareMask mask)
+	{
+		return ((mask & s_evenRowsMask & ~s_rightEdgeMask) >> (s_squaresPerRow - 1)) |
+			((mask & s_oddRowsMask) >> s_squaresPerRow);
+	}
+
+	static constexpr SquareMask StepDownLeft(SquareMask mask)
+	{
+		return (((mask & s_evenRowsMask) << s_squaresPerRow) |
+			((mask & s_oddRowsMask & ~s_leftEdgeMask) << (s_squaresPerRow - 1))) & s_allSquaresMask;
+	}
+
+	static constexpr SquareMask StepDownRight(SquareMask mask)
+	{
+		return (((mask & s_evenRowsMask & ~s_rightEdgeMask) << (s_squaresPerRow + 1)) |
+			((mask & s_oddRowsMask) << s_squaresPerRow)) & s_allSquaresMask;
+	}
+
+	// The four diagonal directions Step takes. Up (towards row 0) comes first, so a piece's directions are always one
+	// contiguous range.
+	static constexpr int32_t s_directionCount = 4;
+	static constexpr int32_t s_firstDownDirection = 2;
+
+	// Steps the mask in the given direction: up left, up right, down left, then down right.
+	static constexpr SquareMask Step(int32_t direction, SquareMask mask)
+	{
+		switch (direction)
+		{
+		case 0:
+			return StepUpLeft(mask);
+		case 1:
+			return StepUpRight(mask);
+		case 2:
+			return StepDownLeft(mask);
+		case 3:
+			return StepDownRight(mask);
+		default:
+			return 0;
+		}
+	}
+
+	// Builds a bit board out of a flat, full size (light squares included) game board.
+	static BasicBitBoard FromGameBoard(std::span<const Piece> gameBoard);
+
+	// Expands the masks back into a flat, full size game board. Used for display, not for rules.
+	std::vector<Piece> ToGameBoard() const;
+};
+
+// The board the game is played on.
+using BitBoard = BasicBitBoard<GameplaySettings::Rules::Geometry>;
+static_assert(BitBoard::s_evenRowsMask == 0x0F0F0F0F && BitBoard::s_leftEdgeMask == 0x10101010 &&
+	BitBoard::s_rightEdgeMask == 0x08080808, "8x8 has to keep its familiar layout.");
+
+// Converting to and from a game board is compiled once, in BitBoard.cpp, for every board size we host.
+extern template struct BasicBitBoard<BoardGeometry<8>>;
+extern template struct BasicBitBoard<BoardGeometry<10>>;
+
+//===============================================================
+
+}
@@ -0,0 +1,118 @@
+//---------------------------------------------------------------
+//
+// BoardGeometry.h
+//
+
+#pragma once
+
+#include "GameTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace Checkers {
+
+//===============================================================
+
+// The shape of an n x n board, as compile time constants. Only the dark squares are playable, and they're numbered
+// in reading order from the top left, so square numbers are checkers notation minus one on any size of board. Row
+// 0 starts on a light square.
+template <int32_t BoardSize>
+struct BoardGeometry
+{
+	static_assert(BoardSize >= 4 && BoardSize % 2 == 0, "Dark squares only alternate evenly on an even sized board.");
+
+	static constexpr int32_t s_boardSize = BoardSize;
+
+	// Every square of the board, light ones included. The flat game board is this long.
+	static constexpr int32_t s_gameSquareCount = BoardSize * BoardSize;
+
+	// Each row holds this many playable squares.
+	static constexpr int32_t s_squaresPerRow = BoardSize / 2;
+
+	static constexpr int32_t s_playableSquareCount = s_gameSquareCount / 2;
+
+	// A bit per playable square. 8x8 fits 32 bits, which is the whole reason it's fast, 10x10 needs 64.
+	using SquareMask = std::conditional_t<(s_playableSquareCount <= 32), uint32_t, uint64_t>;
+	static_assert(s_playableSquareCount <= 64, "Square masks are at most 64 bits.");
+
+	// Every playable square. Bits past the last square are never set.
+	static constexpr SquareMask s_allSquaresMask = s_playableSquareCount == sizeof(SquareMask) * 8 ?
+		~SquareMask{ 0 } :
+		(SquareMask{ 1 } << (s_playableSquareCount % (sizeof(SquareMask) * 8))) - 1;
+
+	// Red starts at the bottom and crowns on row 0, black starts at the top and crowns on the last row.
+	static constexpr int32_t s_redKingRowIndex = 0;
+	static constexpr int32_t s_blackKingRowIndex = BoardSize - 1;
+
+	static constexpr SquareMask GetSquareMask(int32_t square) { return SquareMask{ 1 } << square; }
+
+	// Returns the playable squares of the given row.
+	static constexpr SquareMask GetRowMask(int32_t row)
+	{
+		return ((SquareMask{ 1 } << s_squaresPerRow) - 1) << (row * s_squaresPerRow);
+	}
+
+	// Returns the board coordinate (row, col) of a playable square.
+	static constexpr glm::ivec2 ToCoordFromSquare(int32_t square)
+	{
+		const int32_t row = square / s_squaresPerRow;
+
+		// Even rows start on a light square, so their dark squares are shifted one column over.
+		return { row, 2 * (square % s_squaresPerRow) + (row % 2 == 0 ? 1 : 0) };
+	}
+
+	// Returns the playable square at the given coordinate, or s_invalidSquare for light squares and anything off
+	// the board.
+	static constexpr int32_t ToSquareFromCoord(const glm::ivec2& coord)
+	{
+		if (coord.x < 0 || coord.x >= BoardSize || coord.y < 0 || coord.y >= BoardSize || (coord.x + coord.y) % 2 == 0)
+		{
+			return GameBoardStatics::s_invalidSquare;
+		}
+		return coord.x * s_squaresPerRow + coord.y / 2;
+	}
+
+	// Given a flat array index to a full size game board, returns its playable square, or s_invalidSquare.
+	static constexpr int32_t ToSquareFromGameBoardIndex(int32_t index)
+	{
+		if (index < 0 || index >= s_gameSquareCount)
+		{
+			return GameBoardStatics::s_invalidSquare;
+		}
+		return ToSquareFromCoord({ index / BoardSize, index % BoardSize });
+	}
+
+	// Given a playable square, returns its flat array index to a full size game board.
+	static constexpr int32_t ToGameBoardIndexFromSquare(int32_t square)
+	{
+		const glm::ivec2 coord = ToCoordFromSquare(square);
+		return coord.x * BoardSize + coord.y;
+	}
+
+	// Builds the usual starting position: black pawns on the dark squares of the first pawnRowCount rows, red pawns
+	// on the last pawnRowCount rows, and nothing in between.
+	static constexpr std::array<Piece, s_gameSquareCount> BuildStartingGameBoard(int32_t pawnRowCount)
+	{
+		std::array<Piece, s_gameSquareCount> gameBoard{};
+		gameBoard.fill(GameBoardStatics::s_emptyPiece);
+		for (int32_t square = 0; square < s_playableSquareCount; ++square)
+		{
+			const int32_t row = square / s_squaresPerRow;
+			if (row < pawnRowCount)
+			{
+				gameBoard[ToGameBoardIndexFromSquare(square)] = GameBoardStatics::s_blackPawn;
+			}
+			else if (row >= BoardSize - pawnRowCount)
+			{
+				gameBoard[ToGameBoardIndexFromSquare(square)] = GameBoardStatics::s_redPawn;
+			}
+		}
+		return gameBoard;
+	}
+};
+
+//===============================================================
+
+}
@@ -0,0 +1,93 @@
+//---------------------------------------------------------------
+//
+// CommandLine.h
+//
+
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Checkers {
+namespace CommandLine {
+
+//===============================================================
+
+// Parses the whole of text as a number. Anything left over, or nothing at all, fails.
+template <typename T>
+bool ParseNumber(std::string_view text, T& outValue)
+{
+	const char* end = text.data() + text.size();
+	const auto [ptr, ec] = std::from_chars(text.data(), end, outValue);
+	return ec == std::errc() && ptr == end;
+}
+
+// Parses the whole of text as a number greater than zero.
+inline bool ParsePositiveInt(std::string_view text, int32_t& outValue)
+{
+	return ParseNumber(text, outValue) && outValue > 0;
+}
+
+// The arguments still to be parsed, for options that take more than one value.
+class ArgumentReader
+{
+public:
+	explicit ArgumentReader(std::span<char*> arguments) : m_arguments(arguments) {}
+
+	// Takes the next argument. Returns false if there are none left.
+	bool TryTakeNext(std::string_view& outArgument)
+	{
+		if (m_nextIndex >= m_arguments.size())
+		{
+			return false;
+		}
+		outArgument = m_arguments[m_nextIndex++];
+		return true;
+	}
+
+private:
+	std::span<char*> m_arguments;
+	size_t m_nextIndex = 0;
+};
+
+// Parses "--option value" pairs. Every option takes at least one value, and parseOption(option, value) returns
+// whether it knew the option and the value was good. An option taking more values can ask for a third parameter,
+// the ArgumentReader, and take them from it. Returns false as soon as anything doesn't parse.
+template <typename OptionParser>
+bool ParseOptions(std::span<char*> arguments, OptionParser&& parseOption)
+{
+	ArgumentReader reader(arguments);
+	std::string_view option;
+	while (reader.TryTakeNext(option))
+	{
+		std::string_view value;
+		if (!reader.TryTakeNext(value))
+		{
+			return false;
+		}
+
+		bool isValid = false;
+		if constexpr (std::invocable<OptionParser, std::string_view, std::string_view, ArgumentReader&>)
+		{
+			isValid = parseOption(option, value, reader);
+		}
+		else
+		{
+			isValid = parseOption(option, value);
+		}
+
+		if (!isValid)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//===============================================================
+
+}
+}
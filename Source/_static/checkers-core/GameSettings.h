@@ -0,0 +1,165 @@
+//---------------------------------------------------------------
+//
+// GameSettings.h
+//
+
+#pragma once
+
+#include "GameTypes.h"
+#include "RuleSets.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+struct GameplaySettings {
+
+	// The variant the game is played with. The board settings below all follow from it.
+	using Rules = AmericanRules;
+
+	// These are the only directions that a red pawn may move.
+	static constexpr std::array<glm::ivec2, 2> s_redPawnDirections = { GameBoardStatics::s_upLeft, GameBoardStatics::s_upRight };
+
+	// All kings have the same available directions.
+	static constexpr std::array<glm::ivec2, 4> s_kingDirections = { GameBoardStatics::s_upLeft, GameBoardStatics::s_upRight,
+		GameBoardStatics::s_downLeft, GameBoardStatics::s_downRight };
+
+	// These are the only directions a black pawn may move.
+	static constexpr std::array<glm::ivec2, 2> s_blackPawnDirections = { GameBoardStatics::s_downLeft, GameBoardStatics::s_downRight };
+
+	// Default Board Setup. The game board is initialized with this one.
+	static constexpr std::array<Piece, Rules::Geometry::s_gameSquareCount> s_defaultGameBoard =
+		Rules::Geometry::BuildStartingGameBoard(Rules::s_pawnRowCount);
+
+	// The magnitude to apply to a direction in order to move a piece. (1 space).
+	static constexpr int32_t s_moveDistance = 1;
+
+	// The magnitude to apply to a direction in order to capture a piece. (2 spaces).
+	static constexpr int32_t s_captureDistance = 2;
+
+	// Checkers is a 2 player game.
+	static constexpr int32_t s_playerCount = 2;
+
+	// The board size is n x n.
+	static constexpr int32_t s_boardSize = Rules::Geometry::s_boardSize;
+
+	// Only the dark squares are playable, which is half of the board.
+	static constexpr int32_t s_playableSquareCount = Rules::Geometry::s_playableSquareCount;
+
+	// A red pawn that reaches this rank index will be promoted to king.
+	static constexpr int32_t s_redKingRankIndex = Rules::Geometry::s_redKingRowIndex;
+
+	// A black pawn that reaches this rank index will be promoted to king.
+	static constexpr int32_t s_blackKingRankIndex = Rules::Geometry::s_blackKingRowIndex;
+
+	// A capture chain can never take more pieces than a player starts with.
+	static constexpr int32_t s_maxCaptureChainLength = Rules::s_pieceCount;
+
+	// Official Checkers rules states that an exact game state cannot reappear 3 times, or the game ends in a draw.
+	static constexpr int32_t s_gameStateRuleCount = 3;
+
+	// Default game board view strat.
+	static constexpr GameBoardViewStrategyId s_defaultGameBoardViewStrategy = GameBoardViewStrategyId::CheckersNotation;
+};
+
+struct SearchSettings {
+
+	// Deepest the search will ever iterate to, in plies. Per-ply buffers are sized off of this.
+	static constexpr int32_t s_maxSearchDepth = 64;
+
+	// How deep a computer opponent searches when nothing else is asked for.
+	static constexpr int32_t s_defaultMaxDepth = s_maxSearchDepth;
+
+	// How long a computer opponent may think about a move, in milliseconds, when nothing else is asked for.
+	static constexpr int32_t s_defaultMaxTimeMilliseconds = 500;
+
+	// Most positions one quiescence search may visit before it settles for the static evaluation. Exchanges are
+	// forced and short, so this is only ever hit by kings chasing each other around a sparse board.
+	static constexpr int32_t s_maxQuiescenceNodes = 256;
+
+	// The clock is only read once per this many nodes, reading it every node is measurably slow.
+	static constexpr uint64_t s_nodesPerTimeCheck = 2048;
+
+	// Size of the transposition table the search engine allocates at startup, in megabytes.
+	static constexpr size_t s_transpositionTableMegabytes = 64;
+
+	// Most threads a single search will run on. Lazy SMP stops paying off well before this.
+	static constexpr int32_t s_maxThreadCount = 256;
+};
+
+struct PerftSettings {
+
+	// Deepest perft will count to, in whole turns. Per-ply buffers are sized off of this.
+	static constexpr int32_t s_maxDepth = 32;
+
+	// Perft splits the tree into tasks for the thread pool at the root, or at the second ply from this depth on.
+	// Shallower counts finish too quickly to be worth splitting any finer.
+	static constexpr int32_t s_secondPlySplitDepth = 4;
+};
+
+struct TablebaseSettings {
+
+	// Most pieces, both sides together, endgame databases are built for. Every table up to this is kept in memory
+	// while the larger ones are built, and 8 pieces is about as far as that goes.
+	static constexpr int32_t s_maxPieceCount = 8;
+
+	// Where databases are written to and read from when nothing else is asked for.
+	static constexpr const char* s_defaultDirectory = "tablebases";
+
+	// Each generation pass is split into tasks of this many positions for the thread pool.
+	static constexpr uint64_t s_positionsPerTask = 1 << 16;
+
+	// Table files are compressed in blocks of this many positions, and a probe decompresses the whole block it
+	// lands in. 4 KB of results apiece.
+	static constexpr uint32_t s_positionsPerBlock = 1 << 14;
+
+	// Decompressed blocks each search thread keeps around. Probes from one search cluster in a few tables, so a
+	// handful goes a long way.
+	static constexpr size_t s_cachedBlocksPerThread = 16;
+};
+
+struct OpeningBookSettings {
+
+	// Games only feed the book this many turns in. Past that, games rarely meet in the same position again.
+	static constexpr int32_t s_maxPly = 10;
+
+	// Moves fewer games than this played are left out of the book, a single game says very little about a move.
+	static constexpr int32_t s_minGameCount = 2;
+
+	// Where the book is written to and read from when nothing else is asked for.
+	static constexpr const char* s_defaultPath = "book.cbk";
+
+	// Building splits the corpus into tasks of this many games for the thread pool.
+	static constexpr size_t s_gamesPerTask = 256;
+};
+
+struct LogSettings {
+
+	// Where the async file sink writes. Rotated files get a number before the extension (checkers.1.log, ...).
+	static constexpr const char* s_logFilePath = "logs/checkers.log";
+
+	// A log file is rotated once it would grow past this many bytes.
+	static constexpr size_t s_maxLogFileBytes = 8 * 1024 * 1024;
+
+	// Number of log files kept around, counting the one being written to.
+	static constexpr int32_t s_maxLogFileCount = 3;
+
+	// Records the async sink can hold before it starts dropping them. Must be a power of two.
+	static constexpr size_t s_ringBufferCapacity = 8192;
+
+	// Longest message a record can carry, in bytes. Anything longer is cut off.
+	static constexpr size_t s_maxRecordPayloadLength = 256;
+
+	// The writer thread hands formatted records to the file in writes of about this many bytes.
+	static constexpr size_t s_writeBatchBytes = 64 * 1024;
+
+	// How long the writer thread sleeps when there's nothing to write.
+	static constexpr int32_t s_writerIdleMilliseconds = 20;
+};
+
+//===============================================================
+
+}
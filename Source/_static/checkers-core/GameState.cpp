@@ -0,0 +1,645 @@
+//---------------------------------------------------------------
+//
+// GameState.cpp
+//
+
+#include "GameSettings.h"
+#include "GameState.h"
+#include "GameTypes.h"
+#include "MoveDiscoveryEngine.h"
+#include "PlayerState.h"
+#include "SquareTables.h"
+#include "Trace.h"
+#include "UIEvents.h"
+#include "Utility.h"
+
+#include <spdlog/spdlog.h>
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+#include <spdlog/fmt/ranges.h>
+
+#include <bit>
+#include <deque>
+#include <ranges>
+
+namespace Checkers {
+
+//===============================================================
+
+template <typename EventGetter, typename... Args>
+void GameState::NotifyUIEvent(EventGetter getEvent, Args&&... args)
+{
+	if (m_uiEvents)
+	{
+		(m_uiEvents->*getEvent)().notify(std::forward<Args>(args)...);
+	}
+}
+
+GameState::GameState(UIEvents* uiEvents)
+	: m_moveDiscoveryEngine(std::make_unique<MoveDiscoveryEngine>(this))
+	, m_board(BitBoard::FromGameBoard(GameplaySettings::s_defaultGameBoard))
+	, m_uiEvents(uiEvents)
+{
+	m_zobristKey = Zobrist::GenerateKey(m_board, m_turnPlayerIdentity);
+	CountMaterial();
+
+	// Deep enough for any search or a full game replay without reallocating.
+	static constexpr size_t s_undoJournalReserve = 256;
+	m_undoJournal.reserve(s_undoJournalReserve);
+
+	// Creates both players.
+	m_playerStates.push_back(std::make_unique<PlayerState>(Identity::Red));
+	m_playerStates.push_back(std::make_unique<PlayerState>(Identity::Black));
+}
+
+GameState::~GameState() = default;
+
+GameState::GameState(GameState&& other) noexcept = default;
+
+GameState& GameState::operator=(GameState&& other) noexcept = default;
+
+const std::vector<Piece>& GameState::GetRedPlayerCapturedPieces() const
+{
+	return GetCapturedPiecesForPlayerId(Identity::Red);
+}
+
+const std::vector<Piece>& GameState::GetBlackPlayerCapturedPieces() const
+{
+	return GetCapturedPiecesForPlayerId(Identity::Black);
+}
+
+Identity GameState::GetWinnerId() const
+{
+	switch (m_winConditionState)
+	{
+	case WinConditionReason::AllEnemyPiecesCapturedWin:
+		// The game ends before the turn is handed over, so the turn player made the last capture.
+		return m_turnPlayerIdentity;
+	case WinConditionReason::NoAvailableMovesLoss:
+		return m_turnPlayerIdentity == Identity::Red ? Identity::Black : Identity::Red;
+	case WinConditionReason::GameStateViolationDraw:
+	case WinConditionReason::None:
+	default:
+		return Identity::Neutral;
+	}
+}
+
+std::vector<int32_t> GameState::GetBestHintIndices() const
+{
+	if (!m_isHintsEnabled)
+	{
+		return {};
+	}
+	return m_suggestedHintMove ? MoveDiscoveryEngine::GetHintIndices(*m_suggestedHintMove) :
+		m_moveDiscoveryEngine->GetBestHintIndices();
+}
+
+void GameState::ToggleTurnPlayer()
+{
+	Identity oldTurnPlayer = m_turnPlayerIdentity;
+
+	if (m_turnPlayerIdentity == Identity::Neutral)
+	{
+		// First turn has started, red always goes first.
+		m_turnPlayerIdentity = Identity::Red;
+	}
+	else
+	{
+		m_turnPlayerIdentity = (m_turnPlayerIdentity == Identity::Red) ? Identity::Black : Identity::Red;
+	}
+
+	// Only black's turn mixes into the key, so it flips whenever black gains or loses the turn.
+	if (oldTurnPlayer == Identity::Black || m_turnPlayerIdentity == Identity::Black)
+	{
+		m_zobristKey ^= Zobrist::GetBlackToMoveKey();
+	}
+	NotifyUIEvent(&UIEvents::GetTurnChangedEvent);
+	CHECKERS_TRACE(State, "Player turn change. old {} player new {} player", oldTurnPlayer, m_turnPlayerIdentity);
+
+	HandleTurnStart();
+}
+
+void GameState::MovePiece(const PieceMoveDescription& moveDescription)
+{
+	EnsureAvailableMovesDiscovered();
+	if (!IsMoveDescriptionValid(moveDescription))
+	{
+		return;
+	}
+
+	const std::optional<Piece> sourcePiece = GetPieceFromCoord(Utility::ToGameBoardCoordFromIndex(moveDescription.sourceIndex));
+#ifdef DEBUG
+	// We should 100% have perfectly valid indices and pieces from here out. If not, I wanna know.
+	assert(sourcePiece);
+#endif
+
+	// Cache our source piece to retain context.
+	const Piece movedPiece = *sourcePiece;
+
+	const int32_t distance = Utility::GetDistanceFromSourceIndex(moveDescription.sourceIndex, moveDescription.destIndex);
+	// We can tell by the distance between source/dest if this is a simple move or a capture.
+	const bool isMove = distance == GameplaySettings::s_moveDistance;
+	const bool isCapture = distance == GameplaySettings::s_captureDistance;
+
+	if (isMove)
+	{
+		PerformMove(moveDescription, movedPiece);
+	}
+	else if (isCapture)
+	{
+		// Player has committed to moving this piece, and will be locked into its capture chain.
+		m_touchedCapturingSquare = Utility::ToSquareFromGameBoardIndex(moveDescription.destIndex);
+		PerformCapture(moveDescription, movedPiece);
+
+		// If a capture happened we need to see if we have any more available. Only the pieces around the capture get
+		// searched again.
+		m_moveDiscoveryEngine->ResetDiscoveredMoves();
+		PopulateAvailableMoves();
+	}
+
+	// We just moved a piece, does it need to be kinged?
+	if (ShouldKingPiece(moveDescription.destIndex, movedPiece.identity))
+	{
+		PromotePiece(moveDescription.destIndex, movedPiece);
+	}
+
+	if (CheckAndNotifyWinCondition(WinConditionReason::AllEnemyPiecesCapturedWin) ||
+		CheckAndNotifyWinCondition(WinConditionReason::GameStateViolationDraw))
+	{
+		return;
+	}
+
+	const auto& relevantCaptureList = HasPlayerTouchedPiece() ?
+		m_moveDiscoveryEngine->GetAvailableCapturesForTouchedPiece() :
+		m_moveDiscoveryEngine->GetAvailableCaptures();
+
+	if (!relevantCaptureList.empty())
+	{
+		NotifyUIEvent(&UIEvents::GetAdditionalPieceCaptureRequiredEvent);
+		return;
+	}
+
+	ToggleTurnPlayer();
+}
+
+void GameState::ScopedActivateHintsAndNotify(std::optional<GameMove> suggestedMove)
+{
+	EnsureAvailableMovesDiscovered();
+	m_isHintsEnabled = true;
+	m_suggestedHintMove = suggestedMove;
+	NotifyUIEvent(&UIEvents::GetDisplayHintRequestedEvent);
+	m_suggestedHintMove.reset();
+	m_isHintsEnabled = false;
+}
+
+bool GameState::IsTouchedPiece(int32_t sourceIndex) const
+{
+	if (!Utility::IsValidGameBoardIndex(sourceIndex))
+	{
+		return false;
+	}
+
+	return HasPlayerTouchedPiece() && Utility::ToSquareFromGameBoardIndex(sourceIndex) == m_touchedCapturingSquare;
+}
+
+void GameState::GetLegalMoves(std::vector<GameMove>& outMoves) const
+{
+	MoveDiscoveryEngine::GenerateGameMoves(*this, outMoves);
+}
+
+void GameState::ApplyMove(const GameMove& move)
+{
+#ifdef DEBUG
+	// A finished game takes no more moves.
+	assert(m_winConditionState == WinConditionReason::None);
+#endif
+
+	PlayerState* turnPlayerState = GetTurnPlayerState();
+	uint32_t capturedSquares = move.capturedSquares;
+	while (capturedSquares)
+	{
+		const int32_t capturedSquare = std::countr_zero(capturedSquares);
+		capturedSquares &= capturedSquares - 1;
+		turnPlayerState->CapturePiece(m_board.GetPieceAtSquare(capturedSquare));
+		NotifyUIEvent(&UIEvents::GetPieceCapturedEvent);
+	}
+
+	ApplyMoveToBoard(move);
+	m_touchedCapturingSquare = GameBoardStatics::s_invalidSquare;
+
+	// Same order MovePiece checks in, so a game plays out the same whichever way it's driven.
+	if (CheckAndNotifyWinCondition(WinConditionReason::AllEnemyPiecesCapturedWin) ||
+		CheckAndNotifyWinCondition(WinConditionReason::GameStateViolationDraw))
+	{
+		return;
+	}
+
+	ToggleTurnPlayer();
+}
+
+void GameState::MakeMove(const GameMove& move)
+{
+	UndoRecord& record = m_undoJournal.emplace_back();
+	record.previousZobristKey = m_zobristKey;
+	record.capturedSquares = move.capturedSquares;
+	record.capturedKings = move.capturedSquares & m_board.kings;
+	record.sourceSquare = move.sourceSquare;
+	record.destSquare = move.destSquare;
+	record.previousTouchedSquare = static_cast<int8_t>(m_touchedCapturingSquare);
+	record.wasPromoted = ApplyMoveToBoard(move);
+
+	// The turn is complete, so nothing is touched anymore and the other player is up.
+	m_touchedCapturingSquare = GameBoardStatics::s_invalidSquare;
+	m_turnPlayerIdentity = m_turnPlayerIdentity == Identity::Red ? Identity::Black : Identity::Red;
+	m_zobristKey ^= Zobrist::GetBlackToMoveKey();
+}
+
+bool GameState::ApplyMoveToBoard(const GameMove& move)
+{
+	const uint32_t sourceMask = BitBoard::GetSquareMask(move.sourceSquare);
+	const uint32_t destMask = BitBoard::GetSquareMask(move.destSquare);
+	const Piece movedPiece = m_board.GetPieceAtSquare(move.sourceSquare);
+
+#ifdef DEBUG
+	// Moves are trusted here. The turn player must own the piece being moved.
+	assert(movedPiece.identity == m_turnPlayerIdentity);
+#endif
+
+	const Identity opponentId = movedPiece.identity == Identity::Red ? Identity::Black : Identity::Red;
+	const uint32_t capturedKings = move.capturedSquares & m_board.kings;
+
+	// Work straight on the masks, the per-square setter would re-read every piece we already know about.
+	const bool isPromoted = m_board.ApplyMove(move.sourceSquare, move.destSquare, move.capturedSquares);
+
+	const Piece landedPiece = isPromoted ? Piece{ PieceType::King, movedPiece.identity } : movedPiece;
+	m_zobristKey ^= Zobrist::GetPieceKey(movedPiece, move.sourceSquare) ^ Zobrist::GetPieceKey(landedPiece, move.destSquare);
+
+	uint32_t capturedSquares = move.capturedSquares;
+	while (capturedSquares)
+	{
+		const int32_t capturedSquare = std::countr_zero(capturedSquares);
+		capturedSquares &= capturedSquares - 1;
+		const PieceType capturedType = (capturedKings & BitBoard::GetSquareMask(capturedSquare)) ?
+			PieceType::King : PieceType::Pawn;
+		m_zobristKey ^= Zobrist::GetPieceKey({ capturedType, opponentId }, capturedSquare);
+	}
+
+	// The squares a capture chain passes through are empty before and after, so they don't count as changed.
+	m_squaresChangedSinceDiscovery |= sourceMask | destMask | move.capturedSquares;
+
+	if (isPromoted)
+	{
+		Material& ownMaterial = GetMaterialForId(movedPiece.identity);
+		--ownMaterial.pawnCount;
+		++ownMaterial.kingCount;
+	}
+	if (move.capturedSquares)
+	{
+		Material& opponentMaterial = GetMaterialForId(opponentId);
+		const int32_t capturedKingCount = std::popcount(capturedKings);
+		opponentMaterial.kingCount -= capturedKingCount;
+		opponentMaterial.pawnCount -= std::popcount(move.capturedSquares) - capturedKingCount;
+	}
+
+	return isPromoted;
+}
+
+void GameState::UnmakeMove()
+{
+#ifdef DEBUG
+	// Unmaking more than was made means the caller's bookkeeping is broken.
+	assert(!m_undoJournal.empty());
+#endif
+
+	const UndoRecord& record = m_undoJournal.back();
+	const uint32_t sourceMask = BitBoard::GetSquareMask(record.sourceSquare);
+	const uint32_t destMask = BitBoard::GetSquareMask(record.destSquare);
+
+	// The player who made the move is the one whose turn it was before.
+	m_turnPlayerIdentity = m_turnPlayerIdentity == Identity::Red ? Identity::Black : Identity::Red;
+
+	uint32_t& ownPieces = m_turnPlayerIdentity == Identity::Red ? m_board.red : m_board.black;
+	uint32_t& opponentPieces = m_turnPlayerIdentity == Identity::Red ? m_board.black : m_board.red;
+	const bool wasKing = (m_board.kings & destMask) && !record.wasPromoted;
+
+	ownPieces = (ownPieces & ~destMask) | sourceMask;
+	m_board.kings &= ~destMask;
+	if (wasKing)
+	{
+		m_board.kings |= sourceMask;
+	}
+
+	opponentPieces |= record.capturedSquares;
+	m_board.kings |= record.capturedKings;
+	m_squaresChangedSinceDiscovery |= sourceMask | destMask | record.capturedSquares;
+
+	if (record.wasPromoted)
+	{
+		Material& ownMaterial = GetMaterialForId(m_turnPlayerIdentity);
+		++ownMaterial.pawnCount;
+		--ownMaterial.kingCount;
+	}
+	if (record.capturedSquares)
+	{
+		const Identity opponentId = m_turnPlayerIdentity == Identity::Red ? Identity::Black : Identity::Red;
+		Material& opponentMaterial = GetMaterialForId(opponentId);
+		const int32_t capturedKingCount = std::popcount(record.capturedKings);
+		opponentMaterial.kingCount += capturedKingCount;
+		opponentMaterial.pawnCount += std::popcount(record.capturedSquares) - capturedKingCount;
+	}
+
+	m_touchedCapturingSquare = record.previousTouchedSquare;
+	m_zobristKey = record.previousZobristKey;
+	m_undoJournal.pop_back();
+}
+
+void GameState::CopyPositionFrom(const GameState& other)
+{
+	m_board = other.m_board;
+	m_material = other.m_material;
+	m_zobristKey = other.m_zobristKey;
+	m_turnPlayerIdentity = other.m_turnPlayerIdentity;
+	m_touchedCapturingSquare = other.m_touchedCapturingSquare;
+	m_undoJournal = other.m_undoJournal;
+	m_gameStateOccurrences = other.m_gameStateOccurrences;
+	m_squaresChangedSinceDiscovery = ~uint32_t{ 0 };
+}
+
+bool GameState::HasPositionOccurredInGame() const
+{
+	// Occurrences are counted as soon as a turn's move is made, before the turn passes, so they're keyed with the
+	// player who moved rather than the one now to move.
+	return m_gameStateOccurrences.contains(m_zobristKey ^ Zobrist::GetBlackToMoveKey());
+}
+
+void GameState::SetUpPosition(const BitBoard& board, Identity turnPlayerId)
+{
+	m_board = board;
+	CountMaterial();
+	m_turnPlayerIdentity = turnPlayerId;
+	m_zobristKey = Zobrist::GenerateKey(m_board, m_turnPlayerIdentity);
+	m_winConditionState = WinConditionReason::None;
+	m_undoJournal.clear();
+	m_gameStateOccurrences.clear();
+	m_squaresChangedSinceDiscovery = ~uint32_t{ 0 };
+
+	HandleTurnStart();
+}
+
+
+void GameState::PerformMove(const PieceMoveDescription& moveDescription, const Piece& movedPiece)
+{
+	SetPieceAtSquare(Utility::ToSquareFromGameBoardIndex(moveDescription.sourceIndex), GameBoardStatics::s_emptyPiece);
+	SetPieceAtSquare(Utility::ToSquareFromGameBoardIndex(moveDescription.destIndex), movedPiece);
+}
+
+void GameState::PerformCapture(const PieceMoveDescription& moveDescription, const Piece& movedPiece)
+{
+	// Capture needs to clean up a middle piece.
+	SetPieceAtSquare(Utility::ToSquareFromGameBoardIndex(moveDescription.sourceIndex), GameBoardStatics::s_emptyPiece);
+	SetPieceAtSquare(Utility::ToSquareFromGameBoardIndex(moveDescription.destIndex), movedPiece);
+
+	const int32_t middleSquare = SquareTables::GetJumpedSquare(
+		Utility::ToSquareFromGameBoardIndex(moveDescription.sourceIndex),
+		Utility::ToSquareFromGameBoardIndex(moveDescription.destIndex));
+	GetPlayerStateForId(m_turnPlayerIdentity)->CapturePiece(m_board.GetPieceAtSquare(middleSquare));
+	SetPieceAtSquare(middleSquare, GameBoardStatics::s_emptyPiece);
+
+	NotifyUIEvent(&UIEvents::GetPieceCapturedEvent);
+}
+
+void GameState::PromotePiece(int32_t destIndex, const Piece& movedPiece)
+{
+	SetPieceAtSquare(Utility::ToSquareFromGameBoardIndex(destIndex), movedPiece.identity == Identity::Red ?
+		GameBoardStatics::s_redKing :
+		GameBoardStatics::s_blackKing);
+}
+
+bool GameState::IsMoveDescriptionValid(const PieceMoveDescription& moveDescription)
+{
+	// If we have available captures, we MUST take them and should not even consider available moves.
+	if (m_moveDiscoveryEngine->IsAnyCaptureAvailable())
+	{
+		//If we have already chose a piece, we must choose a capture from its capture chain.
+		if (HasPlayerTouchedPiece() && !m_moveDiscoveryEngine->HasCaptureForTouchedPiece(moveDescription))
+		{
+			spdlog::warn("Player attempted to move when capture with multiple pieces. move={}", moveDescription);
+			NotifyUIEvent(&UIEvents::GetGameplayErrorPromptRequestedEvent, "You must continue capturing with the same piece.");
+			return false;
+		}
+
+		if (!m_moveDiscoveryEngine->HasCapture(moveDescription))
+		{
+			spdlog::warn("Player attempted to move when capture required. move={}", moveDescription);
+			NotifyUIEvent(&UIEvents::GetGameplayErrorPromptRequestedEvent, "A capture is available, you must take it.");
+			return false;
+		}
+	}
+	else if (!m_moveDiscoveryEngine->HasMove(moveDescription))
+	{
+		spdlog::warn("Player attempted unlisted move. move={}", moveDescription);
+		NotifyUIEvent(&UIEvents::GetGameplayErrorPromptRequestedEvent, "This is not a valid move. Choose a different one.");
+		return false;
+	}
+
+	return true;
+}
+
+bool GameState::ShouldKingPiece(int32_t locationIndex, Identity pieceIdentity) const
+{
+	glm::ivec2 currentLocationCoord = Utility::ToGameBoardCoordFromIndex(locationIndex);
+
+	const bool shouldKingRedPiece = pieceIdentity == Identity::Red && currentLocationCoord.x == GameplaySettings::s_redKingRankIndex;
+	const bool shouldKingBlackPiece = pieceIdentity == Identity::Black && currentLocationCoord.x == GameplaySettings::s_blackKingRankIndex;
+	return shouldKingRedPiece || shouldKingBlackPiece;
+}
+
+const std::vector<Piece>& GameState::GetCapturedPiecesForPlayerId(Identity playerId) const
+{
+	const PlayerState* player = GetPlayerStateForId(playerId);
+
+#ifdef DEBUG
+	// If we're here we didn't set the game up properly.
+	assert(player);
+#endif
+
+	return player->GetCapturedPieces();
+}
+
+bool GameState::IsPieceControlledAtCoord(const glm::ivec2& boardCoord)
+{
+	if (!Utility::IsValidGameBoardCoord(boardCoord))
+	{
+		return false;
+	}
+
+	const std::optional<Piece> piece = GetPieceFromCoord(boardCoord);
+	return piece->identity == Identity::Red || piece->identity == Identity::Black;
+}
+
+std::optional<Piece> GameState::GetPieceFromCoord(const glm::ivec2& coord) const
+{
+	if (!Utility::IsValidGameBoardCoord(coord))
+	{
+		return std::nullopt;
+	}
+
+	// Light squares are never stored, but they're always empty.
+	const int32_t square = Utility::ToSquareFromGameBoardIndex(Utility::ToGameBoardIndexFromCoord(coord));
+	return square == GameBoardStatics::s_invalidSquare ? GameBoardStatics::s_emptyPiece : m_board.GetPieceAtSquare(square);
+}
+
+void GameState::HandleTurnStart()
+{
+	m_touchedCapturingSquare = GameBoardStatics::s_invalidSquare;
+	m_moveDiscoveryEngine->ResetDiscoveredMoves();
+	m_areAvailableMovesDiscovered = false;
+
+	// Only MovePiece and hints need the discovered moves, so they're left until one of them asks.
+	CheckAndNotifyWinCondition(WinConditionReason::NoAvailableMovesLoss);
+}
+
+void GameState::PopulateAvailableMoves()
+{
+	// Pieces that didn't see any of the changes keep the moves they had, so most turns only search a few pieces.
+	m_moveDiscoveryEngine->InvalidateSquares(m_squaresChangedSinceDiscovery);
+	m_squaresChangedSinceDiscovery = 0;
+	m_moveDiscoveryEngine->DiscoverMoves(m_turnPlayerIdentity);
+	m_areAvailableMovesDiscovered = true;
+}
+
+void GameState::EnsureAvailableMovesDiscovered()
+{
+	if (!m_areAvailableMovesDiscovered)
+	{
+		PopulateAvailableMoves();
+	}
+}
+
+PlayerState* GameState::GetTurnPlayerState() const
+{
+	return GetPlayerStateForId(m_turnPlayerIdentity);
+}
+
+PlayerState* GameState::GetOpponentPlayerState() const
+{
+	const Identity opponentId = m_turnPlayerIdentity == Identity::Red ? Identity::Black : Identity::Red;
+	return GetPlayerStateForId(opponentId);
+}
+
+PlayerState* GameState::GetPlayerStateForId(Identity id) const
+{
+	auto it = std::find_if(std::begin(m_playerStates), std::end(m_playerStates),
+	[this, id](const std::unique_ptr<PlayerState>& playerState)
+	{
+		return playerState->GetIdentity() == id;
+	});
+	if (it == std::end(m_playerStates))
+	{
+#ifdef DEBUG
+		// If this happens it means we're calling this function before the game has started.
+		assert(false);
+#endif
+		return nullptr;
+	}
+
+	return it->get();
+}
+
+void GameState::SetPieceAtSquare(int32_t square, const Piece& piece)
+{
+	const Piece previousPiece = m_board.GetPieceAtSquare(square);
+	m_zobristKey ^= Zobrist::GetPieceKey(previousPiece, square);
+	m_board.SetPieceAtSquare(square, piece);
+	m_zobristKey ^= Zobrist::GetPieceKey(piece, square);
+	m_squaresChangedSinceDiscovery |= BitBoard::GetSquareMask(square);
+
+	AddMaterial(previousPiece, -1);
+	AddMaterial(piece, 1);
+}
+
+void GameState::AddMaterial(const Piece& piece, int32_t count)
+{
+	if (piece.identity == Identity::Neutral)
+	{
+		return;
+	}
+
+	Material& material = GetMaterialForId(piece.identity);
+	(piece.pieceType == PieceType::King ? material.kingCount : material.pawnCount) += count;
+}
+
+void GameState::CountMaterial()
+{
+	for (const Identity playerId : { Identity::Red, Identity::Black })
+	{
+		const uint32_t pieces = m_board.GetPiecesForId(playerId);
+		Material& material = GetMaterialForId(playerId);
+		material.kingCount = std::popcount(pieces & m_board.kings);
+		material.pawnCount = std::popcount(pieces) - material.kingCount;
+	}
+}
+
+const GameState::Material& GameState::GetMaterial(Identity playerId) const
+{
+	const Material& material = m_material[playerId == Identity::Red ? 0 : 1];
+
+#ifdef DEBUG
+	// If this trips, something changed the board without going through the material bookkeeping.
+	assert(material.GetPieceCount() == m_board.GetPiecesCount(playerId));
+#endif
+
+	return material;
+}
+
+bool GameState::CheckAndNotifyWinCondition(WinConditionReason reason)
+{
+	switch (reason)
+	{
+	case WinConditionReason::AllEnemyPiecesCapturedWin:
+		{
+			const Identity opponentId = GetOpponentPlayerState()->GetIdentity();
+			if (GetMaterial(opponentId).GetPieceCount() == 0)
+			{
+				m_winConditionState = WinConditionReason::AllEnemyPiecesCapturedWin;
+				NotifyUIEvent(&UIEvents::GetWinConditionMetEvent, m_winConditionState);
+			}
+		}
+		return m_winConditionState == reason;
+	case WinConditionReason::NoAvailableMovesLoss:
+		{
+			// Only ever checked at the start of a turn, where the masks tell us the same thing as discovering moves.
+			if (!(MoveDiscoveryEngine::GetMovers(m_board, m_turnPlayerIdentity) |
+				MoveDiscoveryEngine::GetJumpers(m_board, m_turnPlayerIdentity)))
+			{
+				m_winConditionState = WinConditionReason::NoAvailableMovesLoss;
+				NotifyUIEvent(&UIEvents::GetWinConditionMetEvent, m_winConditionState);
+			}
+		}
+		return m_winConditionState == reason;
+	case WinConditionReason::GameStateViolationDraw:
+		{
+			// Our game state just changed. Its Zobrist key is already up to date, we just keep a count of any duplicates.
+			int& occurrenceCount = m_gameStateOccurrences[m_zobristKey];
+			occurrenceCount++;
+			CHECKERS_TRACE(State, "Game state recorded. key={} occurrences={}", m_zobristKey, occurrenceCount);
+			if (occurrenceCount == GameplaySettings::s_gameStateRuleCount)
+			{
+				m_winConditionState = WinConditionReason::GameStateViolationDraw;
+				NotifyUIEvent(&UIEvents::GetWinConditionMetEvent, m_winConditionState);
+			}
+		}
+		return m_winConditionState == reason;
+	// fallthrough
+	case WinConditionReason::None:
+	default:
+		return false;
+	}
+}
+
+
+
+//===============================================================
+
+}
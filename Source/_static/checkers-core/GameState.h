@@ -0,0 +1,267 @@
+//---------------------------------------------------------------
+//
+// GameState.h
+//
+
+#pragma once
+
+#include "IGameStateDisplayInfo.h"
+
+#include "BitBoard.h"
+#include "GameTypes.h"
+#include "Utility.h"
+#include "Zobrist.h"
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+class PlayerState;
+class MoveDiscoveryEngine;
+class UIEvents;
+class GameState : public IGameStateDisplayInfo
+{
+public:
+
+	// Everything MakeMove needs to put the board back the way it was. Pieces that can be worked out from the board
+	// afterwards (the moved piece, the captured pieces' color) aren't stored.
+	struct UndoRecord
+	{
+		// The key before the move was made. Restoring it is cheaper than XORing everything back out.
+		ZobristKey previousZobristKey = 0;
+
+		// Every square that was jumped over.
+		uint32_t capturedSquares = 0;
+
+		// The subset of capturedSquares that held kings.
+		uint32_t capturedKings = 0;
+
+		// Where the moved piece came from and where it ended up.
+		int8_t sourceSquare = GameBoardStatics::s_invalidSquare;
+		int8_t destSquare = GameBoardStatics::s_invalidSquare;
+
+		// True if the moved piece was a pawn that got promoted on arrival.
+		bool wasPromoted = false;
+
+		// The touched capturing piece before the move. A move can be made in the middle of a capture chain.
+		int8_t previousTouchedSquare = GameBoardStatics::s_invalidSquare;
+	};
+
+	// How many of each kind of piece one player has on the board. Kept up to date as pieces move, get captured and
+	// get promoted, so nothing ever has to count the board.
+	struct Material
+	{
+		int32_t pawnCount = 0;
+		int32_t kingCount = 0;
+
+		int32_t GetPieceCount() const { return pawnCount + kingCount; }
+	};
+
+	GameState(const GameState& other) = delete;
+	GameState& operator=(const GameState& other) = delete;
+	// Defined out of line, MoveDiscoveryEngine is incomplete here.
+	GameState(GameState&& other) noexcept;
+	GameState& operator=(GameState&& other) noexcept;
+
+	// Events go to the given UIEvents. With none, the state runs headless: nothing is notified, and the per-piece
+	// move lists MovePiece and hints rely on are only discovered if one of them is actually used.
+	GameState(UIEvents* uiEvents);
+	virtual ~GameState() override;
+
+	// IGameStateDisplayInfo impl
+	std::vector<Piece> GetGameBoardData() const override { return m_board.ToGameBoard(); }
+	const std::vector<Piece>& GetRedPlayerCapturedPieces() const override;
+	const std::vector<Piece>& GetBlackPlayerCapturedPieces() const override;
+	const Identity GetTurnPlayerId() const override { return m_turnPlayerIdentity; }
+	std::vector<int32_t> GetBestHintIndices() const override;
+
+	// Returns the Zobrist key of the current position (board + turn player). It's kept up to date incrementally, so
+	// it's free to call and can be used as a key for any cache of positions.
+	ZobristKey GetZobristKey() const { return m_zobristKey; }
+
+	// Anything other than None indicates a win condition has been met, and describes how.
+	WinConditionReason GetWinState() const { return m_winConditionState; }
+
+	// The player who won, or Neutral while the game is still going or if it was drawn.
+	Identity GetWinnerId() const;
+
+	// Changes the turn player back and forth, or sets the initial player when called for the first time.
+	void ToggleTurnPlayer();
+
+	// Takes the given move description and attempts to move there given the rules of Checkers.
+	void MovePiece(const PieceMoveDescription& moveDescription);
+
+	// Fills outMoves with every whole turn the turn player can make (only the touched piece's, mid-chain).
+	void GetLegalMoves(std::vector<GameMove>& outMoves) const;
+
+	// Plays a whole turn from GetLegalMoves with the full rules of the game: captured pieces are recorded, win
+	// conditions (including repetition) are checked, and the turn is handed over unless the game ended. This is the
+	// headless equivalent of a player's MovePiece calls, and can't be taken back.
+	void ApplyMove(const GameMove& move);
+
+	// Applies a whole turn for the turn player and hands the turn over, recording an undo record. This is the
+	// search/replay path: the move isn't validated, and no UI events, player state updates, discovered move lists
+	// or win checks happen.
+	void MakeMove(const GameMove& move);
+
+	// Takes back the most recent MakeMove, restoring the board, key, turn player and touched piece exactly.
+	void UnmakeMove();
+
+	// Every MakeMove that hasn't been taken back yet, oldest first.
+	std::span<const UndoRecord> GetUndoJournal() const { return m_undoJournal; }
+
+	// Copies another state's position: board, key, turn player, touched piece, undo journal and repetition counts.
+	// Players and discovered moves are left alone, so the copy is only good for MakeMove/UnmakeMove. This is how
+	// search threads get a board of their own.
+	void CopyPositionFrom(const GameState& other);
+
+	// True if the board, with the same player to move, came up earlier in the game. MakeMove doesn't count towards
+	// it, so the search can ask this of the positions it reaches to see the game's repetitions as well as its own.
+	bool HasPositionOccurredInGame() const;
+
+	// Starts over from an arbitrary position with the given player to move, dropping the undo journal and repetition
+	// counts. Used by tools that need positions the starting board never reaches.
+	void SetUpPosition(const BitBoard& board, Identity turnPlayerId);
+
+	// Turns on hints, notifies, then turns off hints. A suggested move, e.g. from the opening book, is shown instead
+	// of the best capture the move discovery engine would pick.
+	void ScopedActivateHintsAndNotify(std::optional<GameMove> suggestedMove = std::nullopt);
+
+	// Returns whether the piece at the source index is our touched piece.
+	bool IsTouchedPiece(int32_t sourceIndex) const;
+
+	// Returns whether the player has touched a piece yet for this turn.
+	// In checkers, when facing multiple pieces that can capture, the player may only choose one piece to execute the
+	// capture chain of.
+	bool HasPlayerTouchedPiece() const { return m_touchedCapturingSquare != GameBoardStatics::s_invalidSquare; }
+
+	// Returns the Piece at the given board coord, or nothing if the coord is off the board.
+	std::optional<Piece> GetPieceFromCoord(const glm::ivec2& coord) const;
+
+	// Returns the authoritative board representation. Rules should prefer this over per-coord lookups.
+	const BitBoard& GetBoard() const { return m_board; }
+
+	// Returns the given player's material.
+	const Material& GetMaterial(Identity playerId) const;
+
+	// Given two pieces, checks and returns their affinity.
+	Affinity GetPieceAffinity(const Identity sourcePieceIdentity, const Identity destPieceIdentity) const;
+
+private:
+	// When a turn changes, we need to evaluate the board to prepare for move requests, among other things.
+	void PopulateAvailableMoves();
+
+	// Discovers the turn's available moves, unless they already have been.
+	void EnsureAvailableMovesDiscovered();
+
+	// Updates the board and key for a whole turn, without touching the turn player. Returns true if the moved piece
+	// was promoted.
+	bool ApplyMoveToBoard(const GameMove& move);
+
+	// Notifies the event UIEvents hands back from getEvent, if we have any UIEvents to notify.
+	template <typename EventGetter, typename... Args>
+	void NotifyUIEvent(EventGetter getEvent, Args&&... args);
+
+	// Moves a piece and updates the game state.
+	void PerformMove(const PieceMoveDescription& moveDescription, const Piece& movedPiece);
+
+	// Captures a piece and updates the game state.
+	void PerformCapture(const PieceMoveDescription& moveDescription, const Piece& movedPiece);
+
+	// Promotes the piece at the given position to a king.
+	void PromotePiece(int32_t destIndex, const Piece& movedPiece);
+
+	// Checks the various conditions that could reject a move request.
+	bool IsMoveDescriptionValid(const PieceMoveDescription& moveDescription);
+
+	// A piece should be promoted if they're in the correct spot on the board.
+	bool ShouldKingPiece(int32_t locationIndex, Identity pieceIdentity) const;
+
+	// Given an ID returns the list of captured pieces recorded in that player state.
+	const std::vector<Piece>& GetCapturedPiecesForPlayerId(Identity playerId) const;
+
+	// Returns true if the piece at the given location is controlled by either player.
+	bool IsPieceControlledAtCoord(const glm::ivec2& boardCoord);
+
+	// When the turn starts, perform some bookkeeping.
+	void HandleTurnStart();
+
+	// Gets the player state object for the current player.
+	PlayerState* GetTurnPlayerState() const;
+
+	// Gets the player state object for the enemy player.
+	PlayerState* GetOpponentPlayerState() const;
+
+	// Returns the player state for a given identity.
+	PlayerState* GetPlayerStateForId(Identity id) const;
+
+	// Places a piece on the board (an empty piece clears the square) and keeps the Zobrist key in sync.
+	void SetPieceAtSquare(int32_t square, const Piece& piece);
+
+	// Adds count of the given piece to its owner's material. A negative count takes them away.
+	void AddMaterial(const Piece& piece, int32_t count);
+
+	// Counts the material up from the board. Only needed when the board is set up from scratch.
+	void CountMaterial();
+
+	Material& GetMaterialForId(Identity playerId) { return m_material[playerId == Identity::Red ? 0 : 1]; }
+
+	// Checks to see if our state satisfies the given win condition reasons, notifies and returns true if so.
+	bool CheckAndNotifyWinCondition(WinConditionReason reason);
+
+private:
+
+	// Each player has a state object with info specific to that player. This list holds each player.
+	std::vector<std::unique_ptr<PlayerState>> m_playerStates;
+
+	// Builds and manages our understanding of available moves and captures for each piece and player.
+	std::unique_ptr<MoveDiscoveryEngine> m_moveDiscoveryEngine;
+
+	// Indicates whose turn it currently is.
+	Identity m_turnPlayerIdentity = Identity::Neutral;
+
+	// The checkers board data. Light squares are never stored, see BitBoard.
+	BitBoard m_board;
+
+	// Material per player, red first. Always matches m_board.
+	std::array<Material, GameplaySettings::s_playerCount> m_material;
+
+	// Current win state of the game
+	WinConditionReason m_winConditionState = WinConditionReason::None;
+
+	// Where UI events go. Null when running headless.
+	UIEvents* m_uiEvents = nullptr;
+
+	// Zobrist key of the board and turn player, updated as pieces move and turns change.
+	ZobristKey m_zobristKey = 0;
+
+	// Keeps track of how many times a specific game state (by Zobrist key) has occurred.
+	std::unordered_map<ZobristKey, int32_t> m_gameStateOccurrences;
+
+	// For capture chains, once a player chooses a piece, they may only move that piece.
+	// This is to handle the case of multiple pieces that can capture. Holds the square the piece is on now.
+	int32_t m_touchedCapturingSquare = GameBoardStatics::s_invalidSquare;
+
+	// One record per MakeMove that hasn't been taken back yet.
+	std::vector<UndoRecord> m_undoJournal;
+
+	// True once this turn's available moves have been discovered.
+	bool m_areAvailableMovesDiscovered = false;
+
+	// Every square that changed since moves were last discovered. Only pieces near these need searching again.
+	uint32_t m_squaresChangedSinceDiscovery = ~uint32_t{ 0 };
+
+	// When true, hints will be displayed to the player.
+	bool m_isHintsEnabled = false;
+
+	// The move hints show while they're on, if it isn't the move discovery engine's pick.
+	std::optional<GameMove> m_suggestedHintMove;
+};
+
+//===============================================================
+}
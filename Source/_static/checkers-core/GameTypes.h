@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <ostream>
@@ -118,28 +119,6 @@ inline std::ostream& operator<<(std::ostream& os, const PieceMoveDescription& mo
 	return os;
 }
 
-struct PieceMoveDescriptionHash
-{
-	std::size_t operator()(const PieceMoveDescription& move) const
-	{
-		std::size_t hash = 0;
-		hash_combine(hash, move.sourceIndex);
-		hash_combine(hash, move.destIndex);
-		return hash;
-	}
-};
-
-struct PieceMoveHint
-{
-	// Used to sort this hint.
-	// A capture chain with 1 entry indicates a basic move with no captures, and so the score will be 0.
-	// 2 entries indicates 1 capture and its score will be 1, etc.
-	size_t score = 0;
-
-	// For a base move (first entry), the series of moves resulting in the highest number of captures.
-	std::vector<PieceMoveDescription> captureChain;
-};
-
 enum class MoveEvaluation : int32_t
 {
 	// The move was not a valid one in any capacity.
@@ -160,11 +139,7 @@ struct Piece
 	// Determines when this piece can move.
 	Identity identity;
 
-	// Uniquely identifies this specific piece.
-	int32_t uid = 0;
-
 	// The combined Piece Type and Identity make up the logical identity of a piece.
-	// Therefore, those are the only values that we include in the hash and equality operator.
 	bool operator==(const Piece& other) const
 	{
 		return pieceType == other.pieceType && identity == other.identity;
@@ -262,6 +237,9 @@ struct GameBoardStatics
 	// Often used for failure to get a valid index.
 	static constexpr int32_t s_invalidBoardIndex = -1;
 
+	// Used for failure to get a valid playable square (see BitBoard).
+	static constexpr int32_t s_invalidSquare = -1;
+
 	// Static helper pieces we can check against when performing game logic.
 	static constexpr Piece s_redPawn { PieceType::Pawn, Identity::Red };
 	static constexpr Piece s_redKing{ PieceType::King, Identity::Red };
@@ -282,27 +260,55 @@ struct GameBoardStatics
 	static constexpr glm::ivec2 s_downLeft = s_down + s_left;
 };
 
-struct GameStateRecord
+// A whole turn for one player, described in playable squares (see BitBoard): either a simple move, or a complete
+// capture chain. Unlike PieceMoveDescription, which is one step of player input, this is what search and replay
+// tools deal in.
+struct GameMove
 {
-	Identity playerIdentity;
-	std::size_t gameBoardHash;
-	bool operator==(const GameStateRecord& other) const
+	// A player only has 12 pieces, so no capture chain can be longer than this.
+	static constexpr int32_t s_maxCaptureChainLength = 12;
+
+	// Playable square the moving piece starts the turn on.
+	int8_t sourceSquare = GameBoardStatics::s_invalidSquare;
+
+	// Playable square the moving piece ends the turn on.
+	int8_t destSquare = GameBoardStatics::s_invalidSquare;
+
+	// Number of jumps in this turn, 0 for a simple move.
+	int8_t captureCount = 0;
+
+	// Every square that was jumped over this turn.
+	uint32_t capturedSquares = 0;
+
+	// Landing square of each jump, in order. Only the first captureCount entries are meaningful, and the last of
+	// those is always destSquare.
+	std::array<int8_t, s_maxCaptureChainLength> jumpPath{};
+
+	constexpr bool IsCapture() const { return captureCount > 0; }
+
+	bool operator==(const GameMove& other) const
 	{
-		return playerIdentity == other.playerIdentity && gameBoardHash== other.gameBoardHash;
+		return sourceSquare == other.sourceSquare && destSquare == other.destSquare &&
+			capturedSquares == other.capturedSquares;
 	}
 };
-
-struct GameStateRecordHash
+// Written in checkers notation (squares are numbered from 1): "9-14" for a simple move, "9x18x25" for a capture chain.
+inline std::ostream& operator<<(std::ostream& os, const GameMove& move)
 {
-	std::size_t operator()(const GameStateRecord& record) const
+	os << move.sourceSquare + 1;
+	if (!move.IsCapture())
 	{
-		std::size_t hash = 0;
-		hash_combine(hash, record.playerIdentity);
-		hash_combine(hash, record.gameBoardHash);
+		os << "-" << move.destSquare + 1;
+		return os;
+	}
 
-		return hash;
+	for (int32_t jump = 0; jump < move.captureCount; ++jump)
+	{
+		os << "x" << move.jumpPath[jump] + 1;
 	}
-};
+	return os;
+}
+
 //===============================================================
 
 }
@@ -24,8 +24,9 @@ public:
 	virtual ~IGameStateDisplayInfo() = default;
 
 
-	// Returns the game data that will be rendered for the player.
-	const virtual std::vector<Piece>& GetGameBoardData() const = 0;
+	// Returns the game data that will be rendered for the player. This is built on demand, so prefer to call it
+	// once per render.
+	virtual std::vector<Piece> GetGameBoardData() const = 0;
 
 	// Returns the list of pieces captured by black player.
 	const virtual std::vector<Piece>& GetBlackPlayerCapturedPieces() const = 0;
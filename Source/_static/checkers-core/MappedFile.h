@@ -0,0 +1,51 @@
+//---------------------------------------------------------------
+//
+// MappedFile.h
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace Checkers {
+
+//===============================================================
+
+// A whole file mapped read-only into memory. Pages are only read in from disk when they're touched, and the OS shares
+// them between every process that maps the same file, so opening even a huge file is instant.
+class MappedFile
+{
+public:
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	MappedFile() = default;
+	~MappedFile();
+
+	// Maps the file at the path, replacing anything mapped before. Returns false if it couldn't be mapped.
+	bool Open(const std::filesystem::path& path);
+
+	// Unmaps the file, if there is one.
+	void Close();
+
+	// The file's contents. Empty if nothing is mapped.
+	std::span<const uint8_t> GetData() const { return { m_data, m_size }; }
+
+private:
+	const uint8_t* m_data = nullptr;
+	size_t m_size = 0;
+
+#ifdef _WIN32
+	// The file mapping object the view was made from.
+	void* m_mappingHandle = nullptr;
+#endif
+};
+
+//===============================================================
+
+}
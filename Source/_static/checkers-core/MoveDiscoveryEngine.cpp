@@ -0,0 +1,512 @@
+//---------------------------------------------------------------
+//
+// MoveDiscoveryEngine.cpp
+//
+
+#include "MoveDiscoveryEngine.h"
+
+#include "GameState.h"
+#include "Trace.h"
+#include "Utility.h"
+
+#include <spdlog/spdlog.h>
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+#include <spdlog/fmt/ranges.h>
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <span>
+
+namespace Checkers {
+
+//===============================================================
+
+// Returns every square whose up (towards row 0) diagonal neighbour is in the mask. Stepping the empty squares
+// this way finds every piece that could move up into one of them.
+static uint32_t GetUpMovers(uint32_t empty)
+{
+	return BitBoard::StepDownLeft(empty) | BitBoard::StepDownRight(empty);
+}
+
+// Returns every square whose down (towards row 7) diagonal neighbour is in the mask.
+static uint32_t GetDownMovers(uint32_t empty)
+{
+	return BitBoard::StepUpLeft(empty) | BitBoard::StepUpRight(empty);
+}
+
+// Returns every square that could jump up over an enemy piece and land on an empty square.
+// A jump needs the same direction twice, so each diagonal is checked on its own.
+static uint32_t GetUpJumpers(uint32_t empty, uint32_t enemy)
+{
+	return BitBoard::StepDownRight(BitBoard::StepDownRight(empty) & enemy) |
+		BitBoard::StepDownLeft(BitBoard::StepDownLeft(empty) & enemy);
+}
+
+// Returns every square that could jump down over an enemy piece and land on an empty square.
+static uint32_t GetDownJumpers(uint32_t empty, uint32_t enemy)
+{
+	return BitBoard::StepUpRight(BitBoard::StepUpRight(empty) & enemy) |
+		BitBoard::StepUpLeft(BitBoard::StepUpLeft(empty) & enemy);
+}
+
+// Red pawns move up the board, black pawns move down it. Kings of either color go both ways.
+static uint32_t GetUpMovingPieces(const BitBoard& board, Identity playerId)
+{
+	const uint32_t pieces = board.GetPiecesForId(playerId);
+	return playerId == Identity::Red ? pieces : pieces & board.kings;
+}
+
+static uint32_t GetDownMovingPieces(const BitBoard& board, Identity playerId)
+{
+	const uint32_t pieces = board.GetPiecesForId(playerId);
+	return playerId == Identity::Black ? pieces : pieces & board.kings;
+}
+
+// Every square one or two steps along a diagonal from each square. That's every square a piece there looks at to
+// decide whether it can move or jump.
+static constexpr std::array<uint32_t, GameplaySettings::s_playableSquareCount> s_diagonalNeighbourhoods = []
+{
+	std::array<uint32_t, GameplaySettings::s_playableSquareCount> neighbourhoods{};
+	for (int32_t square = 0; square < GameplaySettings::s_playableSquareCount; ++square)
+	{
+		for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+		{
+			neighbourhoods[square] |= SquareTables::s_stepMasks[square][direction] | SquareTables::s_jumpMasks[square][direction];
+		}
+	}
+	return neighbourhoods;
+}();
+
+MoveDiscoveryEngine::~MoveDiscoveryEngine() = default;
+
+MoveDiscoveryEngine::MoveDiscoveryEngine(GameState* state)
+	: m_gameState(state)
+{
+}
+
+std::vector<int32_t> MoveDiscoveryEngine::GetBestHintIndices() const
+{
+	// Scoring:
+	// Basic Moves: 0
+	// Captures: score equals size of the capture list.
+
+	if (m_moveHints.empty())
+	{
+		return {};
+	}
+
+	// If a player isn't currently in the middle of a capture chain, we can just recommend
+	// the best chain from the general list. Otherwise, we MUST pick from the touchedPiece's capture chain.
+	// Hints are only asked for now and then, so they're not kept sorted.
+	auto bestHint = std::ranges::max_element(m_moveHints, {}, &PieceMoveHint::score);
+	if (m_gameState->HasPlayerTouchedPiece())
+	{
+		bestHint = std::ranges::find_if(m_moveHints, [this](const PieceMoveHint& hint)
+			{
+				return m_gameState->IsTouchedPiece(Utility::ToGameBoardIndexFromSquare(hint.path.GetSourceSquare()));
+			});
+
+		if (bestHint == m_moveHints.end())
+		{
+#ifdef DEBUG
+			// Something is terribly wrong.
+			assert(false);
+#endif
+			return {};
+		}
+	}
+
+	return GetHintIndices(bestHint->path.ToGameMove());
+}
+
+std::vector<int32_t> MoveDiscoveryEngine::GetHintIndices(const GameMove& move)
+{
+	std::vector<int32_t> hintIndices;
+	hintIndices.reserve(move.captureCount + 2);
+	hintIndices.push_back(Utility::ToGameBoardIndexFromSquare(move.sourceSquare));
+	if (!move.IsCapture())
+	{
+		hintIndices.push_back(Utility::ToGameBoardIndexFromSquare(move.destSquare));
+		return hintIndices;
+	}
+
+	std::ranges::transform(std::span(move.jumpPath).first(move.captureCount), std::back_inserter(hintIndices),
+		[](int8_t landingSquare)
+		{
+			return Utility::ToGameBoardIndexFromSquare(landingSquare);
+		});
+
+	return hintIndices;
+}
+
+uint32_t MoveDiscoveryEngine::GetMovers(const BitBoard& board, Identity playerId)
+{
+	const uint32_t empty = board.GetEmpty();
+	return (GetUpMovingPieces(board, playerId) & GetUpMovers(empty)) |
+		(GetDownMovingPieces(board, playerId) & GetDownMovers(empty));
+}
+
+uint32_t MoveDiscoveryEngine::GetJumpers(const BitBoard& board, Identity playerId)
+{
+	const uint32_t empty = board.GetEmpty();
+	const uint32_t enemy = board.GetOpponentPiecesForId(playerId);
+	return (GetUpMovingPieces(board, playerId) & GetUpJumpers(empty, enemy)) |
+		(GetDownMovingPieces(board, playerId) & GetDownJumpers(empty, enemy));
+}
+
+uint32_t MoveDiscoveryEngine::GetSimpleMoveDestinations(const BitBoard& board, Identity playerId, int32_t sourceSquare)
+{
+	const Piece piece = board.GetPieceAtSquare(sourceSquare);
+	if (piece.identity != playerId)
+	{
+		return 0;
+	}
+
+	return SquareTables::GetStepMasks(sourceSquare, SquareTables::GetDirectionRange(piece)) & board.GetEmpty();
+}
+
+// Extends a capture chain from the piece on fromSquare, recursing for every jump available from there. When no more
+// jumps exist, the finished chain is added to outMoves. firstPieceMoveIndex marks where this piece's chains start
+// in outMoves, so chains that reach the same end by different paths are only added once.
+static void ExtendCaptureChain(int32_t fromSquare, uint32_t empty, uint32_t enemy,
+	SquareTables::DirectionRange directions, GameMove& move, size_t firstPieceMoveIndex, std::vector<GameMove>& outMoves)
+{
+	bool isChainExtended = false;
+	for (int32_t direction = directions.first; direction < directions.last; ++direction)
+	{
+		const uint32_t capturedMask = SquareTables::s_stepMasks[fromSquare][direction] & enemy;
+		const uint32_t landingMask = SquareTables::s_jumpMasks[fromSquare][direction] & empty;
+		if (!capturedMask || !landingMask)
+		{
+			continue;
+		}
+
+		isChainExtended = true;
+		const int32_t landingSquare = SquareTables::s_jumpSquares[fromSquare][direction];
+		move.jumpPath[move.captureCount++] = static_cast<int8_t>(landingSquare);
+		move.capturedSquares |= capturedMask;
+
+		// The captured piece comes off the board, and the jumping piece moves from its square to the landing square.
+		// The square it left is empty again, a king's chain can come back through it.
+		ExtendCaptureChain(landingSquare, (empty | capturedMask | BitBoard::GetSquareMask(fromSquare)) & ~landingMask,
+			enemy & ~capturedMask,
+			directions, move, firstPieceMoveIndex, outMoves);
+
+		move.capturedSquares &= ~capturedMask;
+		--move.captureCount;
+	}
+
+	// Nothing left to jump, the chain ends here.
+	if (!isChainExtended && move.captureCount > 0)
+	{
+		move.destSquare = static_cast<int8_t>(fromSquare);
+		const auto pieceMoves = std::span(outMoves).subspan(firstPieceMoveIndex);
+		if (std::ranges::find(pieceMoves, move) == pieceMoves.end())
+		{
+			outMoves.push_back(move);
+		}
+	}
+}
+
+void MoveDiscoveryEngine::GenerateGameMoves(const BitBoard& board, Identity playerId, std::vector<GameMove>& outMoves)
+{
+	uint32_t jumpers = GetJumpers(board, playerId);
+	if (jumpers)
+	{
+		const uint32_t enemy = board.GetOpponentPiecesForId(playerId);
+		while (jumpers)
+		{
+			const int32_t sourceSquare = std::countr_zero(jumpers);
+			const uint32_t sourceMask = BitBoard::GetSquareMask(sourceSquare);
+			jumpers &= jumpers - 1;
+
+			GameMove move;
+			move.sourceSquare = static_cast<int8_t>(sourceSquare);
+
+			// The jumping piece is lifted off its square, so a king's chain can pass back over it.
+			ExtendCaptureChain(sourceSquare, board.GetEmpty() | sourceMask, enemy,
+				SquareTables::GetDirectionRange(board.GetPieceAtSquare(sourceSquare)), move, outMoves.size(), outMoves);
+		}
+		return;
+	}
+
+	const uint32_t empty = board.GetEmpty();
+	uint32_t movers = GetMovers(board, playerId);
+	while (movers)
+	{
+		const int32_t sourceSquare = std::countr_zero(movers);
+		movers &= movers - 1;
+
+		uint32_t destinations = SquareTables::GetStepMasks(sourceSquare,
+			SquareTables::GetDirectionRange(board.GetPieceAtSquare(sourceSquare))) & empty;
+
+		while (destinations)
+		{
+			GameMove& move = outMoves.emplace_back();
+			move.sourceSquare = static_cast<int8_t>(sourceSquare);
+			move.destSquare = static_cast<int8_t>(std::countr_zero(destinations));
+			destinations &= destinations - 1;
+		}
+	}
+}
+
+void MoveDiscoveryEngine::GenerateGameMoves(const GameState& gameState, std::vector<GameMove>& outMoves)
+{
+	const size_t firstMoveIndex = outMoves.size();
+	GenerateGameMoves(gameState.GetBoard(), gameState.GetTurnPlayerId(), outMoves);
+
+	if (gameState.HasPlayerTouchedPiece())
+	{
+		const auto generatedMoves = outMoves | std::views::drop(firstMoveIndex);
+		const auto removedMoves = std::ranges::remove_if(generatedMoves, [&gameState](const GameMove& move)
+		{
+			return !gameState.IsTouchedPiece(Utility::ToGameBoardIndexFromSquare(move.sourceSquare));
+		});
+		outMoves.erase(removedMoves.begin(), removedMoves.end());
+	}
+}
+
+void MoveDiscoveryEngine::DiscoverMoves(Identity playerId)
+{
+	// Only pieces we don't know about yet need searching, everyone else still has what they had last time.
+	PieceMoveCaches& pieceMoveCaches = GetPieceMoveCaches(playerId);
+	uint32_t& cachedSquares = m_cachedSquares[playerId == Identity::Red ? 0 : 1];
+	uint32_t staleSquares = m_gameState->GetBoard().GetPiecesForId(playerId) & ~cachedSquares;
+	cachedSquares |= staleSquares;
+	while (staleSquares)
+	{
+		const int32_t sourceSquare = std::countr_zero(staleSquares);
+		staleSquares &= staleSquares - 1;
+		RefreshPieceMoveCache(sourceSquare, pieceMoveCaches[sourceSquare]);
+	}
+
+	CollectDiscoveredMoves(playerId);
+}
+
+void MoveDiscoveryEngine::InvalidateSquares(uint32_t changedSquares)
+{
+	if (!changedSquares)
+	{
+		return;
+	}
+
+	for (size_t playerIndex = 0; playerIndex < m_pieceMoveCaches.size(); ++playerIndex)
+	{
+		uint32_t cachedSquares = m_cachedSquares[playerIndex];
+		while (cachedSquares)
+		{
+			const int32_t square = std::countr_zero(cachedSquares);
+			cachedSquares &= cachedSquares - 1;
+			if (m_pieceMoveCaches[playerIndex][square].dependencySquares & changedSquares)
+			{
+				m_cachedSquares[playerIndex] &= ~BitBoard::GetSquareMask(square);
+			}
+		}
+	}
+}
+
+void MoveDiscoveryEngine::ResetDiscoveredMoves()
+{
+	m_touchedPieceAvailableCaptures.Clear();
+	m_availableCaptures.Clear();
+	m_availableMoves.Clear();
+	m_moveHints.clear();
+}
+
+void MoveDiscoveryEngine::CollectDiscoveredMoves(Identity playerId)
+{
+	const PieceMoveCaches& pieceMoveCaches = GetPieceMoveCaches(playerId);
+	const uint32_t pieces = m_gameState->GetBoard().GetPiecesForId(playerId);
+
+	uint32_t jumpers = 0;
+	for (uint32_t remainingPieces = pieces; remainingPieces; remainingPieces &= remainingPieces - 1)
+	{
+		const int32_t square = std::countr_zero(remainingPieces);
+		if (pieceMoveCaches[square].jumpLandings)
+		{
+			jumpers |= BitBoard::GetSquareMask(square);
+		}
+	}
+
+	// Captures are mandatory, so if anything can jump, simple moves will never be accepted.
+	if (jumpers)
+	{
+		while (jumpers)
+		{
+			const int32_t sourceSquare = std::countr_zero(jumpers);
+			jumpers &= jumpers - 1;
+			const PieceMoveCache& pieceMoveCache = pieceMoveCaches[sourceSquare];
+
+			// Only the origin move of a capture chain is available for the player to choose. If a piece has been
+			// touched, it also goes in the available captures specific to that piece.
+			const int32_t sourceIndex = Utility::ToGameBoardIndexFromSquare(sourceSquare);
+			const bool isTouchedPiece = m_gameState->IsTouchedPiece(sourceIndex);
+			uint32_t jumpLandings = pieceMoveCache.jumpLandings;
+			while (jumpLandings)
+			{
+				const int32_t landingSquare = std::countr_zero(jumpLandings);
+				jumpLandings &= jumpLandings - 1;
+
+				const PackedMove originMove(sourceSquare, landingSquare, PackedMove::s_captureFlag);
+				if (isTouchedPiece)
+				{
+					m_touchedPieceAvailableCaptures.Add(originMove);
+				}
+				m_availableCaptures.Add(originMove);
+			}
+
+			const PackedCapturePath& maximalCaptureChain = pieceMoveCache.maximalCaptureChain;
+			m_moveHints.push_back({ static_cast<size_t>(maximalCaptureChain.GetJumpCount()), maximalCaptureChain });
+		}
+		return;
+	}
+
+	for (uint32_t movers = pieces; movers; movers &= movers - 1)
+	{
+		const int32_t sourceSquare = std::countr_zero(movers);
+		const uint32_t destinations = pieceMoveCaches[sourceSquare].moveDestinations;
+
+		// Directions are in square order, so moves still come out lowest destination first.
+		for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+		{
+			if (!(SquareTables::s_stepMasks[sourceSquare][direction] & destinations))
+			{
+				continue;
+			}
+
+			m_availableMoves.Add({ sourceSquare, SquareTables::s_stepSquares[sourceSquare][direction] });
+
+			// Basic moves are visible as hints with a score of 0.
+			m_moveHints.push_back({ 0, PackedCapturePath::FromSimpleMove(sourceSquare, direction) });
+		}
+	}
+}
+
+MoveDiscoveryEngine::PieceMoveCaches& MoveDiscoveryEngine::GetPieceMoveCaches(Identity playerId)
+{
+	return m_pieceMoveCaches[playerId == Identity::Red ? 0 : 1];
+}
+
+void MoveDiscoveryEngine::RefreshPieceMoveCache(int32_t sourceSquare, PieceMoveCache& outCache)
+{
+	const BitBoard& board = m_gameState->GetBoard();
+	const Piece sourcePiece = board.GetPieceAtSquare(sourceSquare);
+	const uint32_t sourceMask = BitBoard::GetSquareMask(sourceSquare);
+	const uint32_t empty = board.GetEmpty();
+	const uint32_t enemy = board.GetOpponentPiecesForId(sourcePiece.identity);
+
+	// Pawns only move forward, kings move both ways. The piece keeps its directions for the whole chain.
+	const SquareTables::DirectionRange directions = SquareTables::GetDirectionRange(sourcePiece);
+	outCache.moveDestinations = SquareTables::GetStepMasks(sourceSquare, directions) & empty;
+
+	// The piece itself counts too, it could be moved, captured or promoted.
+	outCache.jumpLandings = 0;
+	outCache.dependencySquares = sourceMask | s_diagonalNeighbourhoods[sourceSquare];
+	outCache.maximalCaptureChain = PackedCapturePath(sourceSquare);
+
+	CHECKERS_TRACE(MoveGen, "Starting search for {} piece at {}", sourcePiece.identity, sourceSquare);
+
+	m_captureSearchStackSize = 0;
+	PushAvailableJumps({ static_cast<int8_t>(sourceSquare), 0, 0, PackedCapturePath(sourceSquare) }, empty, enemy,
+		directions);
+
+	while (m_captureSearchStackSize > 0)
+	{
+		const CaptureSearchFrame frame = m_captureSearchStack[--m_captureSearchStackSize];
+		const uint32_t capturedMask = SquareTables::s_stepMasks[frame.fromSquare][frame.direction];
+		const uint32_t landingMask = SquareTables::s_jumpMasks[frame.fromSquare][frame.direction];
+		const int32_t landingSquare = SquareTables::s_jumpSquares[frame.fromSquare][frame.direction];
+
+		if (!frame.path.IsCapture())
+		{
+			outCache.jumpLandings |= landingMask;
+		}
+
+		// The chain looks around every square it lands on, so those neighbourhoods decide its outcome as well.
+		outCache.dependencySquares |= s_diagonalNeighbourhoods[landingSquare];
+
+		const CaptureSearchFrame landedFrame = { static_cast<int8_t>(landingSquare), 0,
+			frame.capturedSquares | capturedMask, frame.path.WithJump(frame.direction) };
+		if (PushAvailableJumps(landedFrame, empty, enemy, directions))
+		{
+			continue;
+		}
+
+		// Nothing left to jump, so the chain ends here.
+		if (landedFrame.path.GetJumpCount() > outCache.maximalCaptureChain.GetJumpCount())
+		{
+			outCache.maximalCaptureChain = landedFrame.path;
+		}
+	}
+
+	if (outCache.maximalCaptureChain.IsCapture())
+	{
+		CHECKERS_TRACE(MoveGen, "maximal capture chain={}", outCache.maximalCaptureChain.ToGameMove());
+	}
+}
+
+bool MoveDiscoveryEngine::PushAvailableJumps(const CaptureSearchFrame& frame, uint32_t empty, uint32_t enemy,
+	SquareTables::DirectionRange directions)
+{
+	// The board isn't changed as the chain goes: the jumping piece still blocks its starting square, and captured
+	// pieces block their squares but can't be jumped again.
+	const uint32_t jumpableSquares = enemy & ~frame.capturedSquares;
+
+	bool isJumpAvailable = false;
+	for (int32_t direction = directions.first; direction < directions.last; ++direction)
+	{
+		if (!(SquareTables::s_stepMasks[frame.fromSquare][direction] & jumpableSquares) ||
+			!(SquareTables::s_jumpMasks[frame.fromSquare][direction] & empty))
+		{
+			continue;
+		}
+
+#ifdef DEBUG
+		// If this trips, s_captureSearchStackCapacity's reasoning is wrong.
+		assert(m_captureSearchStackSize < m_captureSearchStack.size());
+#endif
+		CaptureSearchFrame& jumpFrame = m_captureSearchStack[m_captureSearchStackSize++];
+		jumpFrame = frame;
+		jumpFrame.direction = static_cast<int8_t>(direction);
+		isJumpAvailable = true;
+	}
+
+	return isJumpAvailable;
+}
+
+const MoveList& MoveDiscoveryEngine::GetAvailableCapturesForTouchedPiece() const
+{
+	return m_touchedPieceAvailableCaptures;
+}
+
+const MoveList& MoveDiscoveryEngine::GetAvailableCaptures() const
+{
+	return m_availableCaptures;
+}
+
+const MoveList& MoveDiscoveryEngine::GetAvailableMoves() const
+{
+	return m_availableMoves;
+}
+
+bool MoveDiscoveryEngine::HasMove(const PieceMoveDescription& moveDescription) const
+{
+	return m_availableMoves.Contains(moveDescription);
+}
+
+bool MoveDiscoveryEngine::HasCapture(const PieceMoveDescription& moveDescription) const
+{
+	return m_availableCaptures.Contains(moveDescription);
+}
+
+bool MoveDiscoveryEngine::HasCaptureForTouchedPiece(const PieceMoveDescription& moveDescription) const
+{
+	return m_touchedPieceAvailableCaptures.Contains(moveDescription);
+}
+
+//===============================================================
+
+}
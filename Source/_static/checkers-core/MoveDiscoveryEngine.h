@@ -0,0 +1,178 @@
+//---------------------------------------------------------------
+//
+// MoveDiscoveryEngine.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameTypes.h"
+#include "MoveList.h"
+#include "PackedMove.h"
+#include "SquareTables.h"
+
+#include <array>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+class GameState;
+
+struct PieceMoveHint
+{
+	// Used to sort this hint. A basic move with no captures scores 0, a chain with 1 capture scores 1, etc.
+	size_t score = 0;
+
+	// The basic move, or for a piece that can capture, its chain with the highest number of captures.
+	PackedCapturePath path;
+};
+
+class MoveDiscoveryEngine {
+
+public:
+	MoveDiscoveryEngine(const MoveDiscoveryEngine& other) = delete;
+	MoveDiscoveryEngine(MoveDiscoveryEngine&& other) noexcept = default;
+	MoveDiscoveryEngine& operator=(const MoveDiscoveryEngine& other) = delete;
+	MoveDiscoveryEngine& operator=(MoveDiscoveryEngine&& other) noexcept = default;
+
+	~MoveDiscoveryEngine();
+	MoveDiscoveryEngine(GameState* state);
+
+	// Returns the best known set of moves for the current player to take.
+	std::vector<int32_t> GetBestHintIndices() const;
+
+	// Returns the board indices a hint for the whole turn lights up: where it starts, and everywhere it lands.
+	static std::vector<int32_t> GetHintIndices(const GameMove& move);
+
+	// Clears every list of discovered moves. What's known about each piece is kept, see InvalidateSquares.
+	void ResetDiscoveredMoves();
+
+	// Forgets what's known about every piece whose moves or captures could have changed because the given squares
+	// did. A piece only looks at squares within two diagonal steps of wherever its capture chains go, so any piece
+	// that never looked at a changed square keeps what it has.
+	void InvalidateSquares(uint32_t changedSquares);
+
+	// Discovers every move and capture available to the given player. Only pieces that were invalidated, or haven't
+	// been looked at yet, are searched again. Everyone else's moves are reused from the last discovery.
+	void DiscoverMoves(Identity playerId);
+
+	// Returns the squares of every piece the given player owns that can make a simple move.
+	static uint32_t GetMovers(const BitBoard& board, Identity playerId);
+
+	// Returns the squares of every piece the given player owns that can start a capture.
+	static uint32_t GetJumpers(const BitBoard& board, Identity playerId);
+
+	// Returns the squares the given player's piece on the source square could make a simple move to. Whether a
+	// capture is forced instead isn't checked.
+	static uint32_t GetSimpleMoveDestinations(const BitBoard& board, Identity playerId, int32_t sourceSquare);
+
+	// Generates every whole turn (simple move or complete capture chain) the given player can make on the board.
+	// Captures are mandatory, so simple moves are only generated when nothing can jump. Chains are followed the way
+	// GameState plays them out step by step: the jumping piece leaves its square, and each captured piece is removed
+	// as it's jumped. Moves are appended to outMoves. This is stateless, so search threads can share it freely.
+	static void GenerateGameMoves(const BitBoard& board, Identity playerId, std::vector<GameMove>& outMoves);
+
+	// Same as above for the turn player of the given state, and if a capture chain is already underway, only the
+	// touched piece may keep going.
+	static void GenerateGameMoves(const GameState& gameState, std::vector<GameMove>& outMoves);
+
+	// Returns all known captures for the touched piece.
+	const MoveList& GetAvailableCapturesForTouchedPiece() const;
+
+	// Returns all known captures.
+	const MoveList& GetAvailableCaptures() const;
+
+	// Returns all known simple moves.
+	const MoveList& GetAvailableMoves() const;
+
+	// Convenience functions
+	bool HasMove(const PieceMoveDescription& moveDescription) const;
+	bool HasCapture(const PieceMoveDescription& moveDescription) const;
+	bool HasCaptureForTouchedPiece(const PieceMoveDescription& moveDescription) const;
+	bool IsAnyMoveOrCaptureAvailable() const { return IsAnyMoveAvailable() || IsAnyCaptureAvailable(); }
+	bool IsAnyMoveAvailable() const { return !m_availableMoves.empty(); }
+	bool IsAnyCaptureAvailable() const { return !m_availableCaptures.empty(); }
+
+private:
+	// One pending jump in the capture chain search.
+	struct CaptureSearchFrame
+	{
+		// The square the jump starts from.
+		int8_t fromSquare = GameBoardStatics::s_invalidSquare;
+
+		// Which way the jump goes, in BitBoard::Step's order.
+		int8_t direction = 0;
+
+		// Every square the chain already captured, so a piece is never jumped twice.
+		uint32_t capturedSquares = 0;
+
+		// The chain that led to this jump.
+		PackedCapturePath path;
+	};
+
+	// Everything discovered for one piece, kept between discoveries until one of the squares it depends on changes.
+	struct PieceMoveCache
+	{
+		// Squares the piece can make a simple move to.
+		uint32_t moveDestinations = 0;
+
+		// Squares the piece can land on with the first jump of a capture chain.
+		uint32_t jumpLandings = 0;
+
+		// Every square the moves and chains above were worked out from. If none of these change, neither do they.
+		uint32_t dependencySquares = 0;
+
+		// The piece's longest capture chain, for hints. No jumps if it can't capture.
+		PackedCapturePath maximalCaptureChain;
+	};
+
+	// One cache per playable square.
+	using PieceMoveCaches = std::array<PieceMoveCache, GameplaySettings::s_playableSquareCount>;
+
+	// A piece never has more than four jumps to try, and after the first one, one of those always leads back over
+	// the piece it just took. So the stack never holds more than a few frames per capture in the chain.
+	static constexpr size_t s_captureSearchStackCapacity = 4 + 3 * GameplaySettings::s_maxCaptureChainLength;
+
+	// Works out the simple moves, capture starts and maximal capture chain of the piece on the given square from
+	// scratch. The capture search runs on fixed size member buffers, so it never allocates.
+	void RefreshPieceMoveCache(int32_t sourceSquare, PieceMoveCache& outCache);
+
+	// Builds the available move and capture lists and the hints from what's known about every piece of the player.
+	void CollectDiscoveredMoves(Identity playerId);
+
+	// Returns the per-piece caches of the given player.
+	PieceMoveCaches& GetPieceMoveCaches(Identity playerId);
+
+	// Pushes a frame for every jump available from the square, returning false if there are none.
+	bool PushAvailableJumps(const CaptureSearchFrame& frame, uint32_t empty, uint32_t enemy,
+		SquareTables::DirectionRange directions);
+
+	// Stack for the DFS that finds all available captures, and the maximal capture chain.
+	std::array<CaptureSearchFrame, s_captureSearchStackCapacity> m_captureSearchStack;
+	size_t m_captureSearchStackSize = 0;
+
+	// What's known about every square's piece, per player (red first). Only squares in m_cachedSquares are current.
+	std::array<PieceMoveCaches, GameplaySettings::s_playerCount> m_pieceMoveCaches;
+	std::array<uint32_t, GameplaySettings::s_playerCount> m_cachedSquares = {};
+
+	// Used to quickly check if a particular move given to us is a valid one.
+	MoveList m_availableMoves;
+
+	// Cache of available captures associated with the piece a player has chosen to capture with.
+	MoveList m_touchedPieceAvailableCaptures;
+
+	// Used to quickly check if a particular capture given to us is a valid one.
+	MoveList m_availableCaptures;
+
+	// List of Moves and their capture chains so that we can offer hints to the player.
+	std::vector<PieceMoveHint> m_moveHints;
+
+	// ptr to our parent. In order to discover moves, we need to be able to ask questions on the game state.
+	GameState* m_gameState = nullptr;
+};
+
+//===============================================================
+
+}
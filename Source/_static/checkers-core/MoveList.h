@@ -0,0 +1,92 @@
+//---------------------------------------------------------------
+//
+// MoveList.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+#include "PackedMove.h"
+#include "Utility.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+namespace Checkers {
+
+//===============================================================
+
+// A flat list of moves a player can choose from. A turn never offers more than a few dozen, so they live in a fixed
+// size array and adding one never allocates. Next to the list, a 32x32 bit matrix (one row of destination squares
+// per source square) answers whether a move is in the list with a single mask test.
+class MoveList
+{
+public:
+	// A player never has more than 12 pieces, and each of them can go at most four ways.
+	static constexpr size_t s_capacity = 12 * 4;
+
+	// Adds a move, unless it's already in the list.
+	void Add(PackedMove move)
+	{
+		const int32_t sourceSquare = move.GetSourceSquare();
+		const uint32_t destMask = BitBoard::GetSquareMask(move.GetDestSquare());
+		if (m_destinationsBySource[sourceSquare] & destMask)
+		{
+			return;
+		}
+
+#ifdef DEBUG
+		// If this trips, s_capacity's reasoning is wrong.
+		assert(m_size < m_moves.size());
+#endif
+		m_destinationsBySource[sourceSquare] |= destMask;
+		m_moves[m_size++] = move;
+	}
+
+	// Empties the list.
+	void Clear()
+	{
+		m_destinationsBySource = {};
+		m_size = 0;
+	}
+
+	// Returns whether the move is in the list. Moves to or from anywhere a piece can't stand never are.
+	bool Contains(const PieceMoveDescription& moveDescription) const
+	{
+		const int32_t sourceSquare = Utility::ToSquareFromGameBoardIndex(moveDescription.sourceIndex);
+		const int32_t destSquare = Utility::ToSquareFromGameBoardIndex(moveDescription.destIndex);
+		if (sourceSquare == GameBoardStatics::s_invalidSquare || destSquare == GameBoardStatics::s_invalidSquare)
+		{
+			return false;
+		}
+
+		return m_destinationsBySource[sourceSquare] & BitBoard::GetSquareMask(destSquare);
+	}
+
+	// Returns every move, in the order they were added.
+	std::span<const PackedMove> GetMoves() const { return { m_moves.data(), m_size }; }
+
+	const PackedMove* begin() const { return m_moves.data(); }
+	const PackedMove* end() const { return m_moves.data() + m_size; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+private:
+	// The moves themselves. Only the first m_size are meaningful.
+	std::array<PackedMove, s_capacity> m_moves;
+	size_t m_size = 0;
+
+	// Row per source square, bit per destination square.
+	std::array<uint32_t, GameplaySettings::s_playableSquareCount> m_destinationsBySource = {};
+};
+
+//===============================================================
+
+}
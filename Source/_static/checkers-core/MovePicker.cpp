@@ -0,0 +1,242 @@
+//---------------------------------------------------------------
+//
+// MovePicker.cpp
+//
+
+#include "MovePicker.h"
+
+#include "GameState.h"
+#include "MoveDiscoveryEngine.h"
+
+#include <algorithm>
+#include <ranges>
+
+namespace Checkers {
+
+//===============================================================
+
+void MoveHistory::Age()
+{
+	for (size_t playerIndex = 0; playerIndex < m_historyCounts.size(); ++playerIndex)
+	{
+		AgePlayer(playerIndex);
+	}
+}
+
+void MoveHistory::RecordCutoff(Identity playerId, PackedMove move, PackedMove previousMove, int32_t depth)
+{
+	const size_t playerIndex = GetPlayerIndex(playerId);
+	uint32_t& historyCount = m_historyCounts[playerIndex][move.GetSourceSquare()][move.GetDestSquare()];
+	historyCount += std::min(static_cast<uint32_t>(depth * depth), s_maxDepthWeight);
+	if (historyCount >= s_maxCount)
+	{
+		AgePlayer(playerIndex);
+	}
+
+	if (!previousMove.IsNone())
+	{
+		m_counterMoves[playerIndex][previousMove.GetSourceSquare()][previousMove.GetDestSquare()] = move;
+	}
+}
+
+void MoveHistory::RecordSearched(Identity playerId, PackedMove move, int32_t depth)
+{
+	const size_t playerIndex = GetPlayerIndex(playerId);
+	uint32_t& butterflyCount = m_butterflyCounts[playerIndex][move.GetSourceSquare()][move.GetDestSquare()];
+	butterflyCount += std::min(static_cast<uint32_t>(depth * depth), s_maxDepthWeight);
+	if (butterflyCount >= s_maxCount)
+	{
+		AgePlayer(playerIndex);
+	}
+}
+
+uint32_t MoveHistory::GetScore(Identity playerId, PackedMove move) const
+{
+	const size_t playerIndex = GetPlayerIndex(playerId);
+	const uint64_t historyCount = m_historyCounts[playerIndex][move.GetSourceSquare()][move.GetDestSquare()];
+	const uint64_t butterflyCount = m_butterflyCounts[playerIndex][move.GetSourceSquare()][move.GetDestSquare()];
+
+	// A move can't cut off more often than it's searched, so this never goes past s_scoreScale.
+	return static_cast<uint32_t>(historyCount * s_scoreScale / (butterflyCount + 1));
+}
+
+PackedMove MoveHistory::GetCounterMove(Identity playerId, PackedMove previousMove) const
+{
+	return m_counterMoves[GetPlayerIndex(playerId)][previousMove.GetSourceSquare()][previousMove.GetDestSquare()];
+}
+
+void MoveHistory::AgePlayer(size_t playerIndex)
+{
+	for (auto* table : { &m_historyCounts[playerIndex], &m_butterflyCounts[playerIndex] })
+	{
+		for (auto& destCounts : *table)
+		{
+			for (uint32_t& count : destCounts)
+			{
+				count /= 2;
+			}
+		}
+	}
+}
+
+MovePicker::MovePicker(const GameState& gameState, PackedMove hashMove,
+	std::span<const PackedMove, s_killerMoveCount> killerMoves, PackedMove counterMove, const MoveHistory& history,
+	std::vector<GameMove>& moveBuffer)
+	: m_gameState(gameState)
+	, m_hashMove(hashMove)
+	, m_counterMove(counterMove)
+	, m_history(history)
+	, m_moves(moveBuffer)
+{
+	std::ranges::copy(killerMoves, m_killerMoves.begin());
+	m_moves.clear();
+
+	// A capture chain that's underway always has another capture to make, otherwise the turn would be over.
+	const bool isCaptureForced = gameState.HasPlayerTouchedPiece() ||
+		MoveDiscoveryEngine::GetJumpers(gameState.GetBoard(), gameState.GetTurnPlayerId()) != 0;
+	if (!isCaptureForced)
+	{
+		m_stage = Stage::HashMove;
+		return;
+	}
+
+	// There's rarely more than a handful of captures, so they're all generated. The hash move goes to the front.
+	MoveDiscoveryEngine::GenerateGameMoves(gameState, m_moves);
+	if (!m_hashMove.IsNone())
+	{
+		const auto hashMoveIt = std::ranges::find(m_moves, m_hashMove, &PackedMove::FromGameMove);
+		if (hashMoveIt != m_moves.end())
+		{
+			std::iter_swap(m_moves.begin(), hashMoveIt);
+			m_isHashCaptureFirst = true;
+		}
+	}
+}
+
+const GameMove* MovePicker::GetNextMove()
+{
+	switch (m_stage)
+	{
+	case Stage::Captures:
+		if (m_nextMoveIndex < m_moves.size())
+		{
+			return PickNextCapture();
+		}
+		m_stage = Stage::Done;
+		return nullptr;
+
+	case Stage::HashMove:
+		m_stage = Stage::KillerMoves;
+		if (const GameMove* move = PickSimpleMove(m_hashMove))
+		{
+			return move;
+		}
+		[[fallthrough]];
+
+	case Stage::KillerMoves:
+		while (m_nextKillerIndex < m_killerMoves.size())
+		{
+			if (const GameMove* move = PickSimpleMove(m_killerMoves[m_nextKillerIndex++]))
+			{
+				return move;
+			}
+		}
+
+		m_stage = Stage::CounterMove;
+		[[fallthrough]];
+
+	case Stage::CounterMove:
+		m_stage = Stage::GenerateQuietMoves;
+		if (const GameMove* move = PickSimpleMove(m_counterMove))
+		{
+			return move;
+		}
+		[[fallthrough]];
+
+	case Stage::GenerateQuietMoves:
+		m_stage = Stage::QuietMoves;
+		{
+			// Nothing we guessed was good enough, so now every simple move is needed. The ones already handed out
+			// are dropped, and the rest are scored once here rather than every time one is picked.
+			MoveDiscoveryEngine::GenerateGameMoves(m_gameState, m_moves);
+			const auto removedMoves = std::ranges::remove_if(m_moves,
+				[this](const GameMove& move) { return WasSimpleMovePicked(PackedMove::FromGameMove(move)); });
+			m_moves.erase(removedMoves.begin(), removedMoves.end());
+
+			const Identity playerId = m_gameState.GetTurnPlayerId();
+			for (size_t moveIndex = 0; moveIndex < m_moves.size(); ++moveIndex)
+			{
+				m_quietMoveScores[moveIndex] = m_history.GetScore(playerId, PackedMove::FromGameMove(m_moves[moveIndex]));
+			}
+		}
+		[[fallthrough]];
+
+	case Stage::QuietMoves:
+		if (m_nextMoveIndex < m_moves.size())
+		{
+			return PickNextQuietMove();
+		}
+		m_stage = Stage::Done;
+		return nullptr;
+
+	case Stage::Done:
+	default:
+		return nullptr;
+	}
+}
+
+const GameMove* MovePicker::PickNextCapture()
+{
+	if (m_nextMoveIndex == 0 && m_isHashCaptureFirst)
+	{
+		return &m_moves[m_nextMoveIndex++];
+	}
+
+	// Selecting as we go beats sorting up front, since most of the list is usually never reached.
+	const auto remainingMoves = std::span(m_moves).subspan(m_nextMoveIndex);
+	const auto bestMoveIt = std::ranges::max_element(remainingMoves, {}, &GameMove::captureCount);
+	std::iter_swap(remainingMoves.begin(), bestMoveIt);
+	return &m_moves[m_nextMoveIndex++];
+}
+
+const GameMove* MovePicker::PickNextQuietMove()
+{
+	// Same as captures, most of the list is usually never reached.
+	const auto remainingScores = std::span(m_quietMoveScores).subspan(m_nextMoveIndex, m_moves.size() - m_nextMoveIndex);
+	const auto bestScoreIt = std::ranges::max_element(remainingScores);
+	const size_t bestMoveIndex = m_nextMoveIndex + std::distance(remainingScores.begin(), bestScoreIt);
+	std::swap(m_moves[m_nextMoveIndex], m_moves[bestMoveIndex]);
+	std::swap(m_quietMoveScores[m_nextMoveIndex], m_quietMoveScores[bestMoveIndex]);
+	return &m_moves[m_nextMoveIndex++];
+}
+
+const GameMove* MovePicker::PickSimpleMove(PackedMove move)
+{
+	if (move.IsNone() || move.IsCapture() || WasSimpleMovePicked(move))
+	{
+		return nullptr;
+	}
+
+	const uint32_t destinations = MoveDiscoveryEngine::GetSimpleMoveDestinations(m_gameState.GetBoard(),
+		m_gameState.GetTurnPlayerId(), move.GetSourceSquare());
+	if (!(destinations & BitBoard::GetSquareMask(move.GetDestSquare())))
+	{
+		return nullptr;
+	}
+
+	m_pickedSimpleMoves[m_pickedSimpleMoveCount++] = move;
+	m_simpleMove = GameMove{};
+	m_simpleMove.sourceSquare = static_cast<int8_t>(move.GetSourceSquare());
+	m_simpleMove.destSquare = static_cast<int8_t>(move.GetDestSquare());
+	return &m_simpleMove;
+}
+
+bool MovePicker::WasSimpleMovePicked(PackedMove move) const
+{
+	const auto pickedSimpleMoves = std::span(m_pickedSimpleMoves).first(m_pickedSimpleMoveCount);
+	return std::ranges::find(pickedSimpleMoves, move) != pickedSimpleMoves.end();
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,158 @@
+//---------------------------------------------------------------
+//
+// MovePicker.h
+//
+
+#pragma once
+
+#include "GameSettings.h"
+#include "GameTypes.h"
+#include "MoveList.h"
+#include "PackedMove.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+class GameState;
+
+// What one search thread has learned about simple moves, to order the ones it has no better guess for. Every table
+// is indexed by the side to move, then a move's source and dest square. A thread only ever touches its own, so
+// threads searching together never contend over it.
+//   History    - how much each move caused beta cutoffs, weighted towards the ones with the most depth left.
+//   Butterfly  - how much each move was searched at all, weighted the same way. History over butterfly is how often
+//                the move cuts off when it's tried, rather than how often it happens to be tried.
+//   Counters   - the move that last refuted each of the opponent's moves.
+class MoveHistory
+{
+public:
+	// Forgets half of everything, so what's learned in one search still helps the next without drowning it out.
+	void Age();
+
+	// Records that a simple move caused a beta cutoff at the given depth, in reply to previousMove (which may be
+	// none).
+	void RecordCutoff(Identity playerId, PackedMove move, PackedMove previousMove, int32_t depth);
+
+	// Records that a simple move was searched at the given depth.
+	void RecordSearched(Identity playerId, PackedMove move, int32_t depth);
+
+	// Returns how promising a simple move is. Only meaningful compared to other moves.
+	uint32_t GetScore(Identity playerId, PackedMove move) const;
+
+	// Returns the move that last refuted previousMove, or none.
+	PackedMove GetCounterMove(Identity playerId, PackedMove previousMove) const;
+
+private:
+	// A move's weight grows with the square of the depth it was searched at. Cutoffs near the root are rare and decide
+	// far more than the ones near the leaves.
+	static constexpr uint32_t s_maxDepthWeight = SearchSettings::s_maxSearchDepth * SearchSettings::s_maxSearchDepth;
+
+	// Once a counter reaches this, the player's tables are aged so nothing overflows.
+	static constexpr uint32_t s_maxCount = uint32_t{ 1 } << 30;
+
+	// Scales the history to butterfly ratio up into whole numbers.
+	static constexpr uint64_t s_scoreScale = 1 << 16;
+
+	template <typename T>
+	using SquareTable = std::array<std::array<std::array<T, GameplaySettings::s_playableSquareCount>,
+		GameplaySettings::s_playableSquareCount>, GameplaySettings::s_playerCount>;
+
+	static size_t GetPlayerIndex(Identity playerId) { return playerId == Identity::Red ? 0 : 1; }
+
+	// Halves one player's history and butterfly counters.
+	void AgePlayer(size_t playerIndex);
+
+	SquareTable<uint32_t> m_historyCounts = {};
+	SquareTable<uint32_t> m_butterflyCounts = {};
+	SquareTable<PackedMove> m_counterMoves = {};
+};
+
+// Hands a position's moves to the search one at a time, most promising first, and only generates what it has to.
+// Most nodes are cut off by their first move or two, so anything never asked for is never built. The stages are:
+//   Captures   - captures are mandatory, so if anything can jump these are the only moves. Every chain is generated,
+//                the hash move goes first, then the chains taking the most pieces.
+//   Hash move  - the transposition table (or principal variation) move, checked against the board, not generated.
+//   Killers    - simple moves that caused a cutoff at this ply elsewhere in the tree, checked the same way.
+//   Counter    - the simple move that last refuted the opponent's previous move, checked the same way.
+//   Quiet      - every remaining simple move, generated the first time this stage is reached, best history first.
+// The rules all come from MoveDiscoveryEngine, this only decides the order.
+class MovePicker
+{
+public:
+	// Killer moves a picker will try. The search keeps this many per ply.
+	static constexpr size_t s_killerMoveCount = 2;
+
+	MovePicker(const MovePicker& other) = delete;
+	MovePicker& operator=(const MovePicker& other) = delete;
+
+	// The picker generates into moveBuffer, and orders by history, both of which have to outlive it. hashMove and
+	// counterMove may be none.
+	MovePicker(const GameState& gameState, PackedMove hashMove,
+		std::span<const PackedMove, s_killerMoveCount> killerMoves, PackedMove counterMove, const MoveHistory& history,
+		std::vector<GameMove>& moveBuffer);
+
+	// Returns the next move to try, or nullptr once every move has been handed out. The move is only good until the
+	// next call.
+	const GameMove* GetNextMove();
+
+private:
+	enum class Stage : int32_t
+	{
+		Captures,
+		HashMove,
+		KillerMoves,
+		CounterMove,
+		GenerateQuietMoves,
+		QuietMoves,
+		Done
+	};
+
+	// Returns the next capture, taking the most pieces first. Only the moves not yet handed out are looked at.
+	const GameMove* PickNextCapture();
+
+	// Returns the next quiet move, best history first. Only the moves not yet handed out are looked at.
+	const GameMove* PickNextQuietMove();
+
+	// Returns the given simple move if it's playable in this position, nullptr otherwise.
+	const GameMove* PickSimpleMove(PackedMove move);
+
+	// Returns true if the simple move was already handed out by the hash move or killer stages.
+	bool WasSimpleMovePicked(PackedMove move) const;
+
+	const GameState& m_gameState;
+	Stage m_stage = Stage::Captures;
+
+	PackedMove m_hashMove;
+	std::array<PackedMove, s_killerMoveCount> m_killerMoves;
+	PackedMove m_counterMove;
+	const MoveHistory& m_history;
+
+	// True if the hash move is one of the captures, and was put at the front of them.
+	bool m_isHashCaptureFirst = false;
+
+	// Simple moves already handed out, so the quiet stage doesn't hand them out again.
+	std::array<PackedMove, 1 + s_killerMoveCount + 1> m_pickedSimpleMoves;
+	size_t m_pickedSimpleMoveCount = 0;
+
+	// Generated moves, and how many of them have been handed out. The ones handed out are at the front.
+	std::vector<GameMove>& m_moves;
+	size_t m_nextMoveIndex = 0;
+
+	// History score of each quiet move, kept in the same order as m_moves.
+	std::array<uint32_t, MoveList::s_capacity> m_quietMoveScores;
+
+	// Where the next killer to check is.
+	size_t m_nextKillerIndex = 0;
+
+	// Hash and killer moves are built here rather than generated.
+	GameMove m_simpleMove;
+};
+
+//===============================================================
+
+}
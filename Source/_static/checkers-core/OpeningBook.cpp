@@ -0,0 +1,108 @@
+//---------------------------------------------------------------
+//
+// OpeningBook.cpp
+//
+
+#include "OpeningBook.h"
+
+#include "BitBoard.h"
+#include "GameSettings.h"
+#include "PackedMove.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Checkers {
+
+//===============================================================
+
+bool OpeningBook::Open(const std::filesystem::path& path)
+{
+	m_entries = {};
+	if (!m_file.Open(path))
+	{
+		spdlog::warn("Couldn't map opening book. path={}", path.string());
+		return false;
+	}
+
+	const std::span<const uint8_t> data = m_file.GetData();
+	OpeningBookFileHeader header;
+	if (data.size() >= sizeof(header))
+	{
+		std::memcpy(&header, data.data(), sizeof(header));
+	}
+
+	const ZobristKey startPositionKey = Zobrist::GenerateKey(
+		BitBoard::FromGameBoard(GameplaySettings::s_defaultGameBoard), Identity::Red);
+	if (data.size() < sizeof(header) || header.magic != OpeningBookFileHeader::s_magic ||
+		header.version != OpeningBookFileHeader::s_version || header.startPositionKey != startPositionKey ||
+		(data.size() - sizeof(header)) / sizeof(OpeningBookEntry) != header.entryCount)
+	{
+		spdlog::warn("Skipping opening book that isn't one we can read. path={}", path.string());
+		m_file.Close();
+		return false;
+	}
+
+	// The mapping is page aligned and the header keeps the entries 8 byte aligned after it.
+	m_entries = { reinterpret_cast<const OpeningBookEntry*>(data.data() + sizeof(header)), header.entryCount };
+	spdlog::info("Opening book opened. path={} entries={}", path.string(), m_entries.size());
+	return true;
+}
+
+std::span<const OpeningBookEntry> OpeningBook::FindEntries(ZobristKey key) const
+{
+	const auto [first, last] = std::ranges::equal_range(m_entries, key, {}, &OpeningBookEntry::key);
+	return { first, last };
+}
+
+bool OpeningBook::TryGetMove(ZobristKey key, std::span<const GameMove> legalMoves, uint64_t choice,
+	GameMove& outMove) const
+{
+	const std::span<const OpeningBookEntry> entries = FindEntries(key);
+	const auto findLegalMove = [legalMoves](const OpeningBookEntry& entry)
+	{
+		return std::ranges::find_if(legalMoves, [&entry](const GameMove& move)
+		{
+			return PackedCapturePath::FromGameMove(move).GetBits() == entry.move;
+		});
+	};
+
+	uint64_t totalWeight = 0;
+	for (const OpeningBookEntry& entry : entries)
+	{
+		if (entry.weight > 0 && findLegalMove(entry) != legalMoves.end())
+		{
+			totalWeight += entry.weight;
+		}
+	}
+
+	if (totalWeight == 0)
+	{
+		return false;
+	}
+
+	// Entries are heaviest first, so a choice of 0 lands on the heaviest legal one.
+	uint64_t remainingChoice = choice % totalWeight;
+	for (const OpeningBookEntry& entry : entries)
+	{
+		const auto moveIt = findLegalMove(entry);
+		if (entry.weight == 0 || moveIt == legalMoves.end())
+		{
+			continue;
+		}
+
+		if (remainingChoice < entry.weight)
+		{
+			outMove = *moveIt;
+			return true;
+		}
+		remainingChoice -= entry.weight;
+	}
+	return false;
+}
+
+//===============================================================
+
+}
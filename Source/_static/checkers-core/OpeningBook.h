@@ -0,0 +1,93 @@
+//---------------------------------------------------------------
+//
+// OpeningBook.h
+//
+
+#pragma once
+
+#include "GameTypes.h"
+#include "MappedFile.h"
+#include "Zobrist.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace Checkers {
+
+//===============================================================
+
+// One move the book knows for one position. The file is nothing but these after its header, sorted by key and then
+// heaviest move first, so every move of a position sits together and the book can be binary searched in place.
+struct OpeningBookEntry
+{
+	// The position the move is played from.
+	ZobristKey key = 0;
+
+	// The whole turn, see PackedCapturePath. Capture chains with the same endpoints stay apart this way.
+	uint64_t move = 0;
+
+	// How often the move is picked, relative to the position's other moves. Zero means it's never picked.
+	uint16_t weight = 0;
+
+	// How the games that played the move went for the player who played it. Counts stop at the top of their range.
+	uint16_t winCount = 0;
+	uint16_t drawCount = 0;
+	uint16_t lossCount = 0;
+};
+static_assert(sizeof(OpeningBookEntry) == 24, "Entries are read and written as is, they can't have padding.");
+
+// What a book file starts with.
+struct OpeningBookFileHeader
+{
+	static constexpr uint32_t s_magic = 0x4B424B43; // "CKBK"
+	static constexpr uint32_t s_version = 1;
+
+	uint32_t magic = s_magic;
+	uint32_t version = s_version;
+	uint64_t entryCount = 0;
+
+	// Key of the starting position. Keys are only good with the Zobrist tables that made them, so a book whose start
+	// key doesn't match ours was built by a different version and is no use.
+	ZobristKey startPositionKey = 0;
+};
+static_assert(sizeof(OpeningBookFileHeader) == 24, "The header is written as is, it can't have padding.");
+
+// A read-only opening book, memory mapped so opening it is instant and every process playing from the same file
+// shares one copy. Looking a position up is a binary search straight over the mapped entries. Nothing changes after
+// Open, so any number of threads can look moves up at once.
+class OpeningBook
+{
+public:
+	OpeningBook(const OpeningBook& other) = delete;
+	OpeningBook& operator=(const OpeningBook& other) = delete;
+	OpeningBook(OpeningBook&& other) noexcept = default;
+	OpeningBook& operator=(OpeningBook&& other) noexcept = default;
+
+	OpeningBook() = default;
+	~OpeningBook() = default;
+
+	// Maps the book at the path. Returns false, leaving the book empty, if it isn't a book we can read.
+	bool Open(const std::filesystem::path& path);
+
+	bool IsOpen() const { return !m_entries.empty(); }
+	size_t GetEntryCount() const { return m_entries.size(); }
+
+	// Every entry for the position, heaviest first. Empty if the book doesn't know the position.
+	std::span<const OpeningBookEntry> FindEntries(ZobristKey key) const;
+
+	// Picks a book move for the position out of its legal moves, in proportion to their weights: choice, taken modulo
+	// the total weight, says which. A choice of 0 always gets the heaviest move. Only moves that are actually legal
+	// count, which also guards against key collisions. Returns false if the book has nothing worth playing.
+	bool TryGetMove(ZobristKey key, std::span<const GameMove> legalMoves, uint64_t choice, GameMove& outMove) const;
+
+private:
+	MappedFile m_file;
+
+	// Points into m_file.
+	std::span<const OpeningBookEntry> m_entries;
+};
+
+//===============================================================
+
+}
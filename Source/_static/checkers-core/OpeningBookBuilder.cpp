@@ -0,0 +1,269 @@
+//---------------------------------------------------------------
+//
+// OpeningBookBuilder.cpp
+//
+
+#include "OpeningBookBuilder.h"
+
+#include "BitBoard.h"
+#include "GameState.h"
+#include "MoveDiscoveryEngine.h"
+#include "PackedMove.h"
+#include "WorkStealingThreadPool.h"
+
+#include <spdlog/spdlog.h>
+
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace Checkers {
+
+//===============================================================
+
+// Entries keep their counts in 16 bits, anything more just reads as a lot.
+static uint16_t SaturateCount(uint64_t count)
+{
+	return static_cast<uint16_t>(std::min<uint64_t>(count, std::numeric_limits<uint16_t>::max()));
+}
+
+//---------------------------------------------------------------
+
+OpeningBookBuilder::OpeningBookBuilder(int32_t threadCount)
+	: m_threadPool(std::make_unique<WorkStealingThreadPool>(threadCount))
+	, m_workerTallies(std::max(threadCount, 1))
+{
+}
+
+OpeningBookBuilder::~OpeningBookBuilder() = default;
+
+bool OpeningBookBuilder::Build(const std::filesystem::path& corpusPath, const BuildOptions& options,
+	BuildStats& outStats)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+	outStats = {};
+	m_entries.clear();
+
+	std::ifstream corpusFile(corpusPath);
+	if (!corpusFile)
+	{
+		spdlog::error("Couldn't open game corpus. path={}", corpusPath.string());
+		return false;
+	}
+
+	std::vector<std::string> games;
+	std::string line;
+	while (std::getline(corpusFile, line))
+	{
+		if (line.find_first_not_of(" \t\r") != std::string::npos)
+		{
+			games.push_back(std::move(line));
+		}
+	}
+
+	for (MoveTallies& tallies : m_workerTallies)
+	{
+		tallies.clear();
+	}
+
+	std::atomic<uint64_t> skippedGameCount = 0;
+	std::vector<WorkStealingThreadPool::Task> tasks;
+	tasks.reserve((games.size() + OpeningBookSettings::s_gamesPerTask - 1) / OpeningBookSettings::s_gamesPerTask);
+	for (size_t firstGame = 0; firstGame < games.size(); firstGame += OpeningBookSettings::s_gamesPerTask)
+	{
+		const size_t lastGame = std::min(firstGame + OpeningBookSettings::s_gamesPerTask, games.size());
+		tasks.emplace_back([this, &games, &options, &skippedGameCount, firstGame, lastGame](int32_t workerIndex)
+		{
+			for (size_t gameIndex = firstGame; gameIndex < lastGame; ++gameIndex)
+			{
+				if (!AddGame(games[gameIndex], options.maxPly, m_workerTallies[workerIndex]))
+				{
+					spdlog::warn("Skipping game that isn't legal or has no result. game={} text={}", gameIndex + 1,
+						games[gameIndex]);
+					skippedGameCount.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		});
+	}
+	m_threadPool->RunBatch(std::move(tasks));
+
+	// Every worker saw different games, so the same move can turn up in several of their tallies.
+	MoveTallies& mergedTallies = m_workerTallies.front();
+	for (size_t workerIndex = 1; workerIndex < m_workerTallies.size(); ++workerIndex)
+	{
+		for (const auto& [positionMove, tally] : m_workerTallies[workerIndex])
+		{
+			MoveTally& mergedTally = mergedTallies[positionMove];
+			mergedTally.winCount += tally.winCount;
+			mergedTally.drawCount += tally.drawCount;
+			mergedTally.lossCount += tally.lossCount;
+		}
+		m_workerTallies[workerIndex].clear();
+	}
+
+	for (const auto& [positionMove, tally] : mergedTallies)
+	{
+		const uint64_t gameCount = tally.winCount + tally.drawCount + tally.lossCount;
+		if (gameCount < static_cast<uint64_t>(options.minGameCount))
+		{
+			continue;
+		}
+
+		// Points scored with the move, counting a draw as half. Popular moves that do well get played the most, and
+		// moves that only ever lost are kept for their stats but never played.
+		OpeningBookEntry entry;
+		entry.key = positionMove.key;
+		entry.move = positionMove.move;
+		entry.weight = SaturateCount(tally.winCount * 2 + tally.drawCount);
+		entry.winCount = SaturateCount(tally.winCount);
+		entry.drawCount = SaturateCount(tally.drawCount);
+		entry.lossCount = SaturateCount(tally.lossCount);
+		m_entries.push_back(entry);
+	}
+	mergedTallies.clear();
+
+	std::ranges::sort(m_entries, [](const OpeningBookEntry& lhs, const OpeningBookEntry& rhs)
+	{
+		return lhs.key != rhs.key ? lhs.key < rhs.key : (lhs.weight != rhs.weight ? lhs.weight > rhs.weight :
+			lhs.move < rhs.move);
+	});
+
+	outStats.gameCount = games.size() - skippedGameCount.load(std::memory_order_relaxed);
+	outStats.skippedGameCount = skippedGameCount.load(std::memory_order_relaxed);
+	outStats.entryCount = m_entries.size();
+	for (size_t entryIndex = 0; entryIndex < m_entries.size(); ++entryIndex)
+	{
+		if (entryIndex == 0 || m_entries[entryIndex].key != m_entries[entryIndex - 1].key)
+		{
+			++outStats.positionCount;
+		}
+	}
+	outStats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+	spdlog::info("Opening book built. games={} skipped={} positions={} entries={} elapsedMs={}", outStats.gameCount,
+		outStats.skippedGameCount, outStats.positionCount, outStats.entryCount, outStats.elapsed.count());
+	return true;
+}
+
+bool OpeningBookBuilder::Write(const std::filesystem::path& path) const
+{
+	if (path.has_parent_path())
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(path.parent_path(), errorCode);
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		spdlog::error("Couldn't open opening book for writing. path={}", path.string());
+		return false;
+	}
+
+	OpeningBookFileHeader header;
+	header.entryCount = m_entries.size();
+	header.startPositionKey = Zobrist::GenerateKey(BitBoard::FromGameBoard(GameplaySettings::s_defaultGameBoard),
+		Identity::Red);
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(m_entries.data()), m_entries.size() * sizeof(OpeningBookEntry));
+	if (!file)
+	{
+		spdlog::error("Couldn't write opening book. path={}", path.string());
+		return false;
+	}
+	return true;
+}
+
+bool OpeningBookBuilder::AddGame(std::string_view line, int32_t maxPly, MoveTallies& tallies)
+{
+	std::istringstream tokenStream{ std::string(line) };
+	std::vector<std::string> tokens;
+	for (std::string token; tokenStream >> token; )
+	{
+		tokens.push_back(std::move(token));
+	}
+
+	if (tokens.empty())
+	{
+		return false;
+	}
+
+	Identity winnerId = Identity::Neutral;
+	const std::string& resultText = tokens.back();
+	if (resultText == "1-0")
+	{
+		winnerId = Identity::Red;
+	}
+	else if (resultText == "0-1")
+	{
+		winnerId = Identity::Black;
+	}
+	else if (resultText != "1/2-1/2")
+	{
+		return false;
+	}
+
+	GameState gameState(nullptr);
+	gameState.ToggleTurnPlayer();
+
+	// Only the turns that go into the book are replayed. A game that's illegal further in is still a game someone
+	// played these openings in.
+	const size_t turnCount = std::min(tokens.size() - 1, static_cast<size_t>(std::max(maxPly, 0)));
+	std::vector<std::pair<PositionMove, Identity>> bookMoves;
+	bookMoves.reserve(turnCount);
+	std::vector<GameMove> moves;
+	for (size_t turn = 0; turn < turnCount; ++turn)
+	{
+		if (gameState.GetWinState() != WinConditionReason::None)
+		{
+			return false;
+		}
+
+		// Moves are matched on their notation, the same way tournament openings are.
+		moves.clear();
+		MoveDiscoveryEngine::GenerateGameMoves(gameState, moves);
+		const auto it = std::ranges::find_if(moves, [&tokens, turn](const GameMove& move)
+		{
+			return fmt::format("{}", move) == tokens[turn];
+		});
+
+		if (it == moves.end())
+		{
+			return false;
+		}
+
+		bookMoves.push_back({ { gameState.GetZobristKey(), PackedCapturePath::FromGameMove(*it).GetBits() },
+			gameState.GetTurnPlayerId() });
+		gameState.ApplyMove(*it);
+	}
+
+	// Only count the game once it's known to be good, so a bad line leaves nothing behind.
+	for (const auto& [positionMove, playerId] : bookMoves)
+	{
+		MoveTally& tally = tallies[positionMove];
+		if (winnerId == Identity::Neutral)
+		{
+			++tally.drawCount;
+		}
+		else if (winnerId == playerId)
+		{
+			++tally.winCount;
+		}
+		else
+		{
+			++tally.lossCount;
+		}
+	}
+	return true;
+}
+
+//===============================================================
+
+}
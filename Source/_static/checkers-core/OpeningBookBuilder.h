@@ -0,0 +1,123 @@
+//---------------------------------------------------------------
+//
+// OpeningBookBuilder.h
+//
+
+#pragma once
+
+#include "GameSettings.h"
+#include "GameTypes.h"
+#include "OpeningBook.h"
+#include "Zobrist.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+class WorkStealingThreadPool;
+
+// Builds an opening book out of a corpus of finished games. Every game is replayed with the full rules of the game,
+// and each of its first few turns is credited with how the game went for whoever played it. Games are split into
+// tasks across a work-stealing pool, each worker keeps its own tallies, and the tallies are merged at the end.
+//
+// A corpus has one game per line: whole turns in checkers notation, capture chains written out in full (e.g.
+// "9x18x25"), then the result. "1-0" means red, who moves first, won, "0-1" means black did, and "1/2-1/2" is a
+// draw. Blank lines are ignored. Games with an illegal move or no result are skipped with a warning.
+class OpeningBookBuilder
+{
+public:
+
+	// What to build the book from.
+	struct BuildOptions
+	{
+		// Turns from the start of each game that are added to the book.
+		int32_t maxPly = OpeningBookSettings::s_maxPly;
+
+		// Moves fewer games than this played are left out.
+		int32_t minGameCount = OpeningBookSettings::s_minGameCount;
+	};
+
+	// What building found.
+	struct BuildStats
+	{
+		uint64_t gameCount = 0;
+		uint64_t skippedGameCount = 0;
+
+		// Distinct positions and moves in the finished book.
+		uint64_t positionCount = 0;
+		uint64_t entryCount = 0;
+
+		std::chrono::milliseconds elapsed{ 0 };
+	};
+
+	OpeningBookBuilder(const OpeningBookBuilder& other) = delete;
+	OpeningBookBuilder& operator=(const OpeningBookBuilder& other) = delete;
+	OpeningBookBuilder(OpeningBookBuilder&& other) noexcept = delete;
+	OpeningBookBuilder& operator=(OpeningBookBuilder&& other) noexcept = delete;
+
+	// Games are replayed on a work-stealing pool of the given size.
+	OpeningBookBuilder(int32_t threadCount);
+	~OpeningBookBuilder();
+
+	// Builds the book from the corpus at the path, replacing anything built before. Returns false if the corpus
+	// couldn't be read.
+	bool Build(const std::filesystem::path& corpusPath, const BuildOptions& options, BuildStats& outStats);
+
+	// Writes the built book to the path. Returns false if it couldn't be written.
+	bool Write(const std::filesystem::path& path) const;
+
+private:
+
+	// How the games that played one move from one position went, for the player who played it.
+	struct MoveTally
+	{
+		uint64_t winCount = 0;
+		uint64_t drawCount = 0;
+		uint64_t lossCount = 0;
+	};
+
+	// A position's key and a PackedCapturePath's bits.
+	struct PositionMove
+	{
+		ZobristKey key = 0;
+		uint64_t move = 0;
+
+		bool operator==(const PositionMove& other) const = default;
+	};
+
+	struct PositionMoveHash
+	{
+		size_t operator()(const PositionMove& positionMove) const
+		{
+			// Keys are already well mixed, the move only has to tell apart moves from the same position.
+			return static_cast<size_t>(positionMove.key ^ (positionMove.move * 0x9E3779B97F4A7C15ull));
+		}
+	};
+
+	using MoveTallies = std::unordered_map<PositionMove, MoveTally, PositionMoveHash>;
+
+	// Replays one line of the corpus, adding its first maxPly turns to the tallies. Returns false if the line isn't
+	// a legal game with a result.
+	static bool AddGame(std::string_view line, int32_t maxPly, MoveTallies& tallies);
+
+	std::unique_ptr<WorkStealingThreadPool> m_threadPool;
+
+	// One set of tallies per pool thread, indexed by worker index.
+	std::vector<MoveTallies> m_workerTallies;
+
+	// The finished book, in file order.
+	std::vector<OpeningBookEntry> m_entries;
+};
+
+//===============================================================
+
+}
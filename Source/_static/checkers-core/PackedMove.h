@@ -0,0 +1,197 @@
+//---------------------------------------------------------------
+//
+// PackedMove.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameTypes.h"
+#include "SquareTables.h"
+#include "Utility.h"
+
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+// A move between two playable squares in 16 bits, low bits first:
+//   source square  5 bits
+//   dest square    5 bits
+//   flags          6 bits
+// That's one step of player input, or the endpoints of a whole turn. A default constructed move goes from square 0
+// to square 0, which no real move does, so it doubles as "no move".
+class PackedMove
+{
+public:
+	// Set when the move jumps (or, for a whole turn, starts a capture chain).
+	static constexpr uint16_t s_captureFlag = 1 << 10;
+
+	constexpr PackedMove() = default;
+	constexpr PackedMove(int32_t sourceSquare, int32_t destSquare, uint16_t flags = 0)
+		: m_bits(static_cast<uint16_t>((sourceSquare & s_squareMask) |
+			((destSquare & s_squareMask) << s_destSquareShift) | flags))
+	{
+	}
+
+	// Packs the endpoints of a whole turn. Capture chains with the same endpoints pack the same.
+	static constexpr PackedMove FromGameMove(const GameMove& move)
+	{
+		return { move.sourceSquare, move.destSquare, move.IsCapture() ? s_captureFlag : uint16_t{ 0 } };
+	}
+
+	static constexpr PackedMove FromBits(uint16_t bits)
+	{
+		PackedMove move;
+		move.m_bits = bits;
+		return move;
+	}
+
+	constexpr uint16_t GetBits() const { return m_bits; }
+	constexpr int32_t GetSourceSquare() const { return m_bits & s_squareMask; }
+	constexpr int32_t GetDestSquare() const { return (m_bits >> s_destSquareShift) & s_squareMask; }
+	constexpr bool IsCapture() const { return m_bits & s_captureFlag; }
+	constexpr bool IsNone() const { return m_bits == 0; }
+
+	// Unpacks into board indices, the way player input describes a move.
+	PieceMoveDescription ToPieceMoveDescription() const
+	{
+		return { Utility::ToGameBoardIndexFromSquare(GetSourceSquare()),
+			Utility::ToGameBoardIndexFromSquare(GetDestSquare()) };
+	}
+
+	constexpr bool operator==(const PackedMove& other) const = default;
+
+private:
+	static constexpr uint16_t s_squareMask = 0x1F;
+	static constexpr int32_t s_destSquareShift = 5;
+
+	uint16_t m_bits = 0;
+};
+static_assert(sizeof(PackedMove) == 2);
+
+// A whole turn in one 64 bit word, low bits first:
+//   source square  5 bits
+//   jump count     4 bits
+//   directions     2 bits per step, in order (see BitBoard::Step)
+// A simple move is stored as no jumps, with its one step's direction in the first slot. Everything else about the
+// turn (where each jump lands, what it captures) follows from walking the directions, so this is all a record of the
+// turn needs to keep.
+class PackedCapturePath
+{
+public:
+	constexpr PackedCapturePath() = default;
+
+	// Starts a capture chain at the given square, with no jumps in it yet.
+	explicit constexpr PackedCapturePath(int32_t sourceSquare)
+		: m_bits(static_cast<uint64_t>(sourceSquare) & s_squareMask)
+	{
+	}
+
+	// Returns a simple move from the given square, one step in the given direction.
+	static constexpr PackedCapturePath FromSimpleMove(int32_t sourceSquare, int32_t direction)
+	{
+		PackedCapturePath path(sourceSquare);
+		path.m_bits |= static_cast<uint64_t>(direction) << s_directionsShift;
+		return path;
+	}
+
+	// Packs a whole turn. Its squares have to line up diagonally, the way generated moves always do.
+	static constexpr PackedCapturePath FromGameMove(const GameMove& move)
+	{
+		if (!move.IsCapture())
+		{
+			return FromSimpleMove(move.sourceSquare,
+				FindDirection(SquareTables::s_stepSquares[move.sourceSquare], move.destSquare));
+		}
+
+		PackedCapturePath path(move.sourceSquare);
+		int32_t fromSquare = move.sourceSquare;
+		for (int32_t jump = 0; jump < move.captureCount; ++jump)
+		{
+			path = path.WithJump(FindDirection(SquareTables::s_jumpSquares[fromSquare], move.jumpPath[jump]));
+			fromSquare = move.jumpPath[jump];
+		}
+		return path;
+	}
+
+	// Returns this chain with one more jump on the end, in the given direction.
+	constexpr PackedCapturePath WithJump(int32_t direction) const
+	{
+		const int32_t jumpCount = GetJumpCount();
+		PackedCapturePath path;
+		path.m_bits = (m_bits & ~(s_jumpCountMask << s_jumpCountShift)) |
+			(static_cast<uint64_t>(jumpCount + 1) << s_jumpCountShift) |
+			(static_cast<uint64_t>(direction) << (s_directionsShift + jumpCount * s_directionBits));
+		return path;
+	}
+
+	// Walks the directions back out into the full turn.
+	constexpr GameMove ToGameMove() const
+	{
+		GameMove move;
+		move.sourceSquare = static_cast<int8_t>(GetSourceSquare());
+
+		int32_t fromSquare = move.sourceSquare;
+		const int32_t jumpCount = GetJumpCount();
+		if (jumpCount == 0)
+		{
+			move.destSquare = SquareTables::s_stepSquares[fromSquare][GetDirection(0)];
+			return move;
+		}
+
+		for (int32_t jump = 0; jump < jumpCount; ++jump)
+		{
+			const int32_t direction = GetDirection(jump);
+			move.capturedSquares |= SquareTables::s_stepMasks[fromSquare][direction];
+			fromSquare = SquareTables::s_jumpSquares[fromSquare][direction];
+			move.jumpPath[move.captureCount++] = static_cast<int8_t>(fromSquare);
+		}
+		move.destSquare = move.jumpPath[jumpCount - 1];
+		return move;
+	}
+
+	constexpr int32_t GetSourceSquare() const { return static_cast<int32_t>(m_bits & s_squareMask); }
+	constexpr int32_t GetJumpCount() const { return static_cast<int32_t>((m_bits >> s_jumpCountShift) & s_jumpCountMask); }
+	constexpr bool IsCapture() const { return GetJumpCount() > 0; }
+	constexpr uint64_t GetBits() const { return m_bits; }
+
+	// Returns the direction of the given step of the turn.
+	constexpr int32_t GetDirection(int32_t step) const
+	{
+		return static_cast<int32_t>((m_bits >> (s_directionsShift + step * s_directionBits)) & s_directionMask);
+	}
+
+	constexpr bool operator==(const PackedCapturePath& other) const = default;
+
+private:
+	static constexpr uint64_t s_squareMask = 0x1F;
+	static constexpr int32_t s_jumpCountShift = 5;
+	static constexpr uint64_t s_jumpCountMask = 0xF;
+	static constexpr int32_t s_directionsShift = 9;
+	static constexpr int32_t s_directionBits = 2;
+	static constexpr uint64_t s_directionMask = 0x3;
+	static_assert(s_directionsShift + s_directionBits * GameMove::s_maxCaptureChainLength <= 64,
+		"The longest capture chain has to fit in the word.");
+
+	// Returns the direction whose entry in a square's step or jump table row is the given square.
+	static constexpr int32_t FindDirection(const SquareTables::DirectionSquares& destSquares, int32_t destSquare)
+	{
+		for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+		{
+			if (destSquares[direction] == destSquare)
+			{
+				return direction;
+			}
+		}
+		return 0;
+	}
+
+	uint64_t m_bits = 0;
+};
+static_assert(sizeof(PackedCapturePath) == 8);
+
+//===============================================================
+
+}
@@ -0,0 +1,230 @@
+//---------------------------------------------------------------
+//
+// PerftEngine.cpp
+//
+
+#include "PerftEngine.h"
+
+#include "GameState.h"
+#include "MoveDiscoveryEngine.h"
+#include "WorkStealingThreadPool.h"
+
+#include <spdlog/spdlog.h>
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace Checkers {
+
+//===============================================================
+
+// Layout of a hash entry's data word: the depth in the low 8 bits, the node count in the rest.
+static constexpr int32_t s_hashNodesShift = 8;
+static constexpr uint64_t s_hashDepthMask = 0xFF;
+
+// The same position is stored once per depth, so the depth is mixed into where it lands.
+static constexpr uint64_t s_hashDepthMixer = 0x9E3779B97F4A7C15ull;
+
+//---------------------------------------------------------------
+
+PerftEngine::PerftEngine(int32_t threadCount, size_t hashMegabytes)
+	: m_threadPool(std::make_unique<WorkStealingThreadPool>(threadCount))
+{
+	m_workers.resize(m_threadPool->GetThreadCount());
+	for (PerftWorker& worker : m_workers)
+	{
+		// Workers only ever make and unmake moves on their copy, which runs headless.
+		worker.position = std::make_unique<GameState>(nullptr);
+		worker.moveBuffers = CreateMoveBuffers();
+	}
+
+	if (hashMegabytes > 0)
+	{
+		static constexpr size_t s_bytesPerMegabyte = 1024 * 1024;
+		m_hashEntryCount = std::bit_floor(std::max<size_t>(hashMegabytes * s_bytesPerMegabyte / sizeof(HashEntry), 1));
+		m_hashEntries = std::make_unique<HashEntry[]>(m_hashEntryCount);
+	}
+}
+
+PerftEngine::~PerftEngine() = default;
+
+PerftResult PerftEngine::Run(const GameState& gameState, int32_t depth)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	PerftResult result;
+	result.depth = std::clamp(depth, 1, PerftSettings::s_maxDepth);
+
+	std::vector<GameMove> rootMoves;
+	MoveDiscoveryEngine::GenerateGameMoves(gameState, rootMoves);
+
+	// Workers add into these as their subtrees finish.
+	std::vector<std::atomic<uint64_t>> rootMoveNodes(rootMoves.size());
+
+	if (result.depth == 1)
+	{
+		std::ranges::fill(rootMoveNodes, 1);
+	}
+	else
+	{
+		// Deep counts are split at the second ply as well. A few root moves usually own most of the tree, and
+		// splitting them up is what gives the other workers something to steal.
+		const bool isSecondPlySplit = result.depth >= PerftSettings::s_secondPlySplitDepth;
+		const int32_t taskDepth = result.depth - (isSecondPlySplit ? 2 : 1);
+
+		// The pool is idle until the batch starts, so any worker's position can be used to look ahead.
+		GameState& scratchPosition = *m_workers.front().position;
+		scratchPosition.CopyPositionFrom(gameState);
+
+		std::vector<WorkStealingThreadPool::Task> tasks;
+		std::vector<GameMove> secondPlyMoves;
+		for (size_t rootMoveIndex = 0; rootMoveIndex < rootMoves.size(); ++rootMoveIndex)
+		{
+			const GameMove& rootMove = rootMoves[rootMoveIndex];
+			std::atomic<uint64_t>& nodes = rootMoveNodes[rootMoveIndex];
+			if (!isSecondPlySplit)
+			{
+				tasks.emplace_back([this, &gameState, &rootMove, &nodes, taskDepth](int32_t workerIndex)
+				{
+					PerftWorker& worker = m_workers[workerIndex];
+					worker.position->CopyPositionFrom(gameState);
+					worker.position->MakeMove(rootMove);
+					nodes.fetch_add(CountLeaves(*worker.position, taskDepth, 0, worker.moveBuffers), std::memory_order_relaxed);
+				});
+				continue;
+			}
+
+			scratchPosition.MakeMove(rootMove);
+			secondPlyMoves.clear();
+			MoveDiscoveryEngine::GenerateGameMoves(scratchPosition, secondPlyMoves);
+			scratchPosition.UnmakeMove();
+
+			for (const GameMove& secondPlyMove : secondPlyMoves)
+			{
+				tasks.emplace_back([this, &gameState, &rootMove, secondPlyMove, &nodes, taskDepth](int32_t workerIndex)
+				{
+					PerftWorker& worker = m_workers[workerIndex];
+					worker.position->CopyPositionFrom(gameState);
+					worker.position->MakeMove(rootMove);
+					worker.position->MakeMove(secondPlyMove);
+					nodes.fetch_add(CountLeaves(*worker.position, taskDepth, 0, worker.moveBuffers), std::memory_order_relaxed);
+				});
+			}
+		}
+
+		m_threadPool->RunBatch(std::move(tasks));
+	}
+
+	result.rootMoveCounts.reserve(rootMoves.size());
+	for (size_t rootMoveIndex = 0; rootMoveIndex < rootMoves.size(); ++rootMoveIndex)
+	{
+		const uint64_t nodes = rootMoveNodes[rootMoveIndex].load(std::memory_order_relaxed);
+		result.rootMoveCounts.push_back({ rootMoves[rootMoveIndex], nodes });
+		result.nodes += nodes;
+	}
+
+	result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	spdlog::info("Perft complete. player={} depth={} nodes={} elapsedMs={} threads={} hashEntries={}",
+		gameState.GetTurnPlayerId(), result.depth, result.nodes, result.elapsed.count(),
+		m_threadPool->GetThreadCount(), m_hashEntryCount);
+	return result;
+}
+
+uint64_t PerftEngine::CountLeaves(GameState& gameState, int32_t depth, int32_t ply,
+	std::vector<std::vector<GameMove>>& moveBuffers)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	// A mid-chain position shares its key with the same board at the start of a turn, but not its moves.
+	const bool canUseHash = depth > 1 && !gameState.HasPlayerTouchedPiece();
+	const ZobristKey key = gameState.GetZobristKey();
+	uint64_t nodes = 0;
+	if (canUseHash && ProbeHash(key, depth, nodes))
+	{
+		return nodes;
+	}
+
+	std::vector<GameMove>& moves = moveBuffers[ply];
+	moves.clear();
+	MoveDiscoveryEngine::GenerateGameMoves(gameState, moves);
+
+	// Every move one turn from the end is a leaf, there's no need to play them out.
+	if (depth == 1)
+	{
+		return moves.size();
+	}
+
+	for (const GameMove& move : moves)
+	{
+		gameState.MakeMove(move);
+		nodes += CountLeaves(gameState, depth - 1, ply + 1, moveBuffers);
+		gameState.UnmakeMove();
+	}
+
+	if (canUseHash)
+	{
+		StoreHash(key, depth, nodes);
+	}
+	return nodes;
+}
+
+bool PerftEngine::ProbeHash(ZobristKey key, int32_t depth, uint64_t& outNodes) const
+{
+	if (!m_hashEntries)
+	{
+		return false;
+	}
+
+	const HashEntry& entry = m_hashEntries[(key ^ (depth * s_hashDepthMixer)) & (m_hashEntryCount - 1)];
+	const uint64_t data = entry.data.load(std::memory_order_relaxed);
+	const uint64_t keyXorData = entry.keyXorData.load(std::memory_order_relaxed);
+	if ((keyXorData ^ data) != key || static_cast<int32_t>(data & s_hashDepthMask) != depth)
+	{
+		return false;
+	}
+
+	outNodes = data >> s_hashNodesShift;
+	return true;
+}
+
+void PerftEngine::StoreHash(ZobristKey key, int32_t depth, uint64_t nodes)
+{
+	if (!m_hashEntries)
+	{
+		return;
+	}
+
+	// Counts too big for the entry just don't get stored. Nothing that finishes in a human lifetime gets close.
+	if (nodes >> (64 - s_hashNodesShift))
+	{
+		return;
+	}
+
+	HashEntry& entry = m_hashEntries[(key ^ (depth * s_hashDepthMixer)) & (m_hashEntryCount - 1)];
+	const uint64_t data = (nodes << s_hashNodesShift) | static_cast<uint64_t>(depth);
+	entry.data.store(data, std::memory_order_relaxed);
+	entry.keyXorData.store(key ^ data, std::memory_order_relaxed);
+}
+
+std::vector<std::vector<GameMove>> PerftEngine::CreateMoveBuffers()
+{
+	// Comfortably more than any real position has, so move generation never has to grow these.
+	static constexpr size_t s_moveBufferReserve = 64;
+
+	std::vector<std::vector<GameMove>> moveBuffers(PerftSettings::s_maxDepth);
+	for (std::vector<GameMove>& moveBuffer : moveBuffers)
+	{
+		moveBuffer.reserve(s_moveBufferReserve);
+	}
+	return moveBuffers;
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,114 @@
+//---------------------------------------------------------------
+//
+// PerftEngine.h
+//
+
+#pragma once
+
+#include "GameSettings.h"
+#include "GameTypes.h"
+#include "Zobrist.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+// Everything a perft run found.
+struct PerftResult
+{
+	// How many leaves sit under one of the root moves.
+	struct RootMoveCount
+	{
+		GameMove move;
+		uint64_t nodes = 0;
+	};
+
+	// Depth that was counted to, in whole turns.
+	int32_t depth = 0;
+
+	// Leaves at that depth, over every root move.
+	uint64_t nodes = 0;
+
+	// The "divide" breakdown, in the order the root moves were generated.
+	std::vector<RootMoveCount> rootMoveCounts;
+
+	// Wall clock time the count took.
+	std::chrono::milliseconds elapsed{ 0 };
+};
+
+class GameState;
+class WorkStealingThreadPool;
+
+// Counts every position reachable in exactly N whole turns (a simple move, or a complete capture chain) from a
+// position. Moves come from MoveDiscoveryEngine and are played with MakeMove, so mandatory captures, promotion and
+// the touched piece rule all behave exactly like they do in a game. Any change to move generation has to leave these
+// counts alone, and the time it takes is a direct measure of how fast the rules run.
+class PerftEngine
+{
+public:
+	PerftEngine(const PerftEngine& other) = delete;
+	PerftEngine& operator=(const PerftEngine& other) = delete;
+	PerftEngine(PerftEngine&& other) noexcept = delete;
+	PerftEngine& operator=(PerftEngine&& other) noexcept = delete;
+
+	// Counts run on a work-stealing pool of the given size. A non-zero hash size turns on a shared table of subtree
+	// counts, so transpositions only get counted out once.
+	PerftEngine(int32_t threadCount, size_t hashMegabytes);
+	~PerftEngine();
+
+	// Counts the leaves depth turns below the given state's position. The state isn't touched.
+	PerftResult Run(const GameState& gameState, int32_t depth);
+
+private:
+
+	// Per-worker scratch space, so counting never allocates or locks.
+	struct PerftWorker
+	{
+		// A private copy of the root position to make moves on.
+		std::unique_ptr<GameState> position;
+
+		// One move list per ply.
+		std::vector<std::vector<GameMove>> moveBuffers;
+	};
+
+	// A subtree count, stored and read without locks the same way the transposition table does it: a torn entry
+	// won't XOR back to its key and reads as a miss.
+	struct HashEntry
+	{
+		std::atomic<uint64_t> keyXorData;
+		std::atomic<uint64_t> data;
+	};
+
+	// Counts the leaves depth turns below the position the state is in now, leaving the state as it was found. ply
+	// indexes the move buffers.
+	uint64_t CountLeaves(GameState& gameState, int32_t depth, int32_t ply,
+		std::vector<std::vector<GameMove>>& moveBuffers);
+
+	// Looks up the subtree count for a position at a depth. Returns true and fills outNodes on a hit.
+	bool ProbeHash(ZobristKey key, int32_t depth, uint64_t& outNodes) const;
+	void StoreHash(ZobristKey key, int32_t depth, uint64_t nodes);
+
+	// Builds the per-ply move buffers for one worker.
+	static std::vector<std::vector<GameMove>> CreateMoveBuffers();
+
+	std::unique_ptr<WorkStealingThreadPool> m_threadPool;
+
+	// One per pool thread, indexed by worker index.
+	std::vector<PerftWorker> m_workers;
+
+	// Subtree counts. Empty when hashing is off.
+	std::unique_ptr<HashEntry[]> m_hashEntries;
+
+	// Always zero or a power of two, so keys map to entries with a mask.
+	size_t m_hashEntryCount = 0;
+};
+
+//===============================================================
+
+}
@@ -7,6 +7,8 @@
 
 #include "GameTypes.h"
 
+#include <vector>
+
 namespace Checkers {
 
 //===============================================================
@@ -22,9 +24,6 @@ public:
 	PlayerState(Identity identity);
 	~PlayerState();
 
-	// Returns a view of piece that this player specifically owns. we use auto because...
-	size_t GetPiecesCount(const std::vector<Piece>& gameBoard) const;
-
 	// Returns our list of captured pieces.
 	const std::vector<Piece>& GetCapturedPieces() const;
 
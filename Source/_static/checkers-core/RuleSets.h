@@ -0,0 +1,81 @@
+//---------------------------------------------------------------
+//
+// RuleSets.h
+//
+
+#pragma once
+
+#include "BoardGeometry.h"
+
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+// Each variant we host is a set of compile time constants. Everything that plays a variant takes one of these as a
+// template parameter, so its rules are folded in when it's compiled and nothing is decided at runtime. Every rule
+// set has the same members:
+//   Geometry                  - the board (see BoardGeometry).
+//   s_pawnRowCount            - rows of pawns each side starts with.
+//   s_pieceCount              - pieces each side starts with, which also bounds a capture chain.
+//   s_canPawnsCaptureBackward - pawns always move forward, but in some variants they may capture either way.
+//   s_areKingsFlying          - kings move, and capture from, any distance along a diagonal rather than one square.
+//   s_mustCaptureMost         - of the available captures, only the ones taking the most pieces may be played.
+//   s_isPromotedMidCapture    - a pawn passing the far row mid chain is crowned there and carries on as a king.
+// In every variant captures are mandatory, and captured pieces stay on the board until the chain ends: they can't
+// be jumped twice, and in the variants with flying kings they block. Where kings only jump one square a chain never
+// lands on a square it captured on, so the console game taking them off as they're jumped (see
+// GameState::MovePiece) plays the same turns.
+
+// American checkers, English draughts. The game the console plays.
+struct AmericanRules
+{
+	using Geometry = BoardGeometry<8>;
+	static constexpr int32_t s_pawnRowCount = 3;
+	static constexpr int32_t s_pieceCount = s_pawnRowCount * Geometry::s_squaresPerRow;
+	static constexpr bool s_canPawnsCaptureBackward = false;
+	static constexpr bool s_areKingsFlying = false;
+	static constexpr bool s_mustCaptureMost = false;
+	static constexpr bool s_isPromotedMidCapture = false;
+};
+
+// International draughts, on 10x10. A pawn that passes the far row mid chain stays a pawn.
+struct InternationalRules
+{
+	using Geometry = BoardGeometry<10>;
+	static constexpr int32_t s_pawnRowCount = 4;
+	static constexpr int32_t s_pieceCount = s_pawnRowCount * Geometry::s_squaresPerRow;
+	static constexpr bool s_canPawnsCaptureBackward = true;
+	static constexpr bool s_areKingsFlying = true;
+	static constexpr bool s_mustCaptureMost = true;
+	static constexpr bool s_isPromotedMidCapture = false;
+};
+
+// Russian draughts. Any capture may be chosen, and a pawn crowned mid chain keeps capturing as a king.
+struct RussianRules
+{
+	using Geometry = BoardGeometry<8>;
+	static constexpr int32_t s_pawnRowCount = 3;
+	static constexpr int32_t s_pieceCount = s_pawnRowCount * Geometry::s_squaresPerRow;
+	static constexpr bool s_canPawnsCaptureBackward = true;
+	static constexpr bool s_areKingsFlying = true;
+	static constexpr bool s_mustCaptureMost = false;
+	static constexpr bool s_isPromotedMidCapture = true;
+};
+
+// Brazilian draughts, international rules on an 8x8 board.
+struct BrazilianRules
+{
+	using Geometry = BoardGeometry<8>;
+	static constexpr int32_t s_pawnRowCount = 3;
+	static constexpr int32_t s_pieceCount = s_pawnRowCount * Geometry::s_squaresPerRow;
+	static constexpr bool s_canPawnsCaptureBackward = true;
+	static constexpr bool s_areKingsFlying = true;
+	static constexpr bool s_mustCaptureMost = true;
+	static constexpr bool s_isPromotedMidCapture = false;
+};
+
+//===============================================================
+
+}
@@ -0,0 +1,533 @@
+//---------------------------------------------------------------
+//
+// SearchEngine.cpp
+//
+
+#include "SearchEngine.h"
+
+#include "BitBoard.h"
+#include "GameState.h"
+#include "MoveDiscoveryEngine.h"
+#include "MovePicker.h"
+#include "Utility.h"
+
+#include <spdlog/spdlog.h>
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <thread>
+
+namespace Checkers {
+
+//===============================================================
+
+// Material is what matters most. Kings are worth more than pawns because they can move both ways.
+static constexpr int32_t s_pawnValue = 100;
+static constexpr int32_t s_kingValue = 130;
+
+// Pawns are worth a little more the closer they get to being kinged.
+static constexpr int32_t s_pawnAdvancementValue = 2;
+
+// Returns how many rows the given player's pawns have advanced, summed over every pawn.
+static int32_t GetPawnAdvancement(const BitBoard& board, Identity playerId)
+{
+	const uint32_t pawns = board.GetPiecesForId(playerId) & ~board.kings;
+
+	int32_t advancement = 0;
+	for (int32_t row = 0; row < GameplaySettings::s_boardSize; ++row)
+	{
+		const uint32_t rowMask = BitBoard::s_firstRowMask << (row * BitBoard::s_squaresPerRow);
+
+		// Red starts at the bottom and moves up, black starts at the top and moves down.
+		const int32_t rowsAdvanced = playerId == Identity::Red ? GameplaySettings::s_boardSize - 1 - row : row;
+		advancement += std::popcount(pawns & rowMask) * rowsAdvanced;
+	}
+	return advancement;
+}
+
+// Returns the material and advancement score of one player's pieces.
+static int32_t GetPlayerScore(const GameState& gameState, Identity playerId)
+{
+	const GameState::Material& material = gameState.GetMaterial(playerId);
+	return material.pawnCount * s_pawnValue + material.kingCount * s_kingValue +
+		GetPawnAdvancement(gameState.GetBoard(), playerId) * s_pawnAdvancementValue;
+}
+
+// Scores at least this big can only come from a forced win found somewhere in the search.
+static constexpr int32_t s_forcedWinThreshold = SearchEngine::s_winScore - SearchSettings::s_maxSearchDepth - 1;
+
+// Tablebase wins and losses are certain, but say nothing about how long they take. They score well clear of anything
+// material alone could reach, yet below the forced wins the search proves, with the static evaluation added so the
+// winning side still heads for simpler positions instead of shuffling.
+static constexpr int32_t s_tablebaseWinScore = s_forcedWinThreshold / 2;
+
+// Win scores count down from the root, but a table entry can be reached at any ply. Entries store win scores
+// relative to their own position, and get converted back for the ply they're found at.
+static int32_t ToTableScore(int32_t score, int32_t ply)
+{
+	return score >= s_forcedWinThreshold ? score + ply : (score <= -s_forcedWinThreshold ? score - ply : score);
+}
+
+static int32_t FromTableScore(int32_t score, int32_t ply)
+{
+	return score >= s_forcedWinThreshold ? score - ply : (score <= -s_forcedWinThreshold ? score + ply : score);
+}
+
+// Helper threads skip some depths so they aren't all searching the same iteration in lockstep. Helper n skips
+// depths in runs of s_skipSizes[n], offset by s_skipPhases[n], which spreads the helpers over a few neighbouring
+// depths. Past the end of the table the pattern repeats.
+static constexpr std::array<int32_t, 20> s_skipSizes = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+static constexpr std::array<int32_t, 20> s_skipPhases = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+static bool ShouldHelperSkipDepth(int32_t threadIndex, int32_t depth)
+{
+	const size_t skipIndex = static_cast<size_t>(threadIndex - 1) % s_skipSizes.size();
+	return ((depth + s_skipPhases[skipIndex]) / s_skipSizes[skipIndex]) % 2 != 0;
+}
+
+//---------------------------------------------------------------
+
+SearchEngine::SearchEngine(size_t transpositionTableMegabytes, int32_t threadCount)
+	: m_transpositionTable(transpositionTableMegabytes)
+{
+	SetThreadCount(threadCount);
+}
+
+SearchEngine::~SearchEngine() = default;
+
+void SearchEngine::SetThreadCount(int32_t threadCount)
+{
+	threadCount = std::clamp(threadCount, 1, SearchSettings::s_maxThreadCount);
+	m_threads.resize(threadCount);
+	for (int32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+	{
+		std::unique_ptr<SearchThread>& thread = m_threads[threadIndex];
+		if (thread)
+		{
+			continue;
+		}
+
+		thread = std::make_unique<SearchThread>();
+		thread->threadIndex = threadIndex;
+		thread->pvTable.resize(s_maxPly);
+		thread->moveBuffers.resize(s_maxPly);
+
+		// Comfortably more than any real position has, so move generation never has to grow these.
+		static constexpr size_t s_moveBufferReserve = 64;
+		for (std::vector<GameMove>& moveBuffer : thread->moveBuffers)
+		{
+			moveBuffer.reserve(s_moveBufferReserve);
+		}
+
+		// Helpers only ever make and unmake moves on their copy, which runs headless.
+		if (threadIndex > 0)
+		{
+			thread->position = std::make_unique<GameState>(nullptr);
+		}
+	}
+
+	spdlog::info("Search thread count set. threadCount={}", threadCount);
+}
+
+SearchEngine::SearchResult SearchEngine::Search(GameState& gameState, const SearchLimits& limits)
+{
+	SearchResult result;
+
+	m_isStopRequested.store(false, std::memory_order_relaxed);
+	m_transpositionTable.AdvanceGeneration();
+	for (const std::unique_ptr<SearchThread>& thread : m_threads)
+	{
+		thread->nodes = 0;
+		thread->completedScore = 0;
+		thread->completedDepth = 0;
+		thread->previousPrincipalVariation.clear();
+		thread->killerMoves = {};
+		thread->history.Age();
+	}
+
+	SearchThread& mainThread = *m_threads.front();
+	std::vector<GameMove>& rootMoves = mainThread.moveBuffers[0];
+	rootMoves.clear();
+	MoveDiscoveryEngine::GenerateGameMoves(gameState, rootMoves);
+	if (rootMoves.empty())
+	{
+		return result;
+	}
+
+	// There is always something to play, even if the search gets stopped right away.
+	result.bestMove = rootMoves.front();
+	result.principalVariation = { rootMoves.front() };
+	result.hasMove = true;
+
+	// Nothing to think about.
+	if (rootMoves.size() == 1)
+	{
+		return result;
+	}
+
+	// Well known openings are played straight from the book, searching them again every game gains nothing.
+	GameMove bookMove;
+	if (m_openingBook && !gameState.HasPlayerTouchedPiece() &&
+		m_openingBook->TryGetMove(gameState.GetZobristKey(), rootMoves, m_bookMoveRandom(), bookMove))
+	{
+		result.bestMove = bookMove;
+		result.principalVariation = { bookMove };
+		result.isBookMove = true;
+		spdlog::info("Book move played. player={} move={}", gameState.GetTurnPlayerId(), bookMove);
+		return result;
+	}
+
+	const auto searchDeadline = std::chrono::steady_clock::now() + limits.maxTime;
+	const int32_t maxDepth = std::clamp(limits.maxDepth, 1, SearchSettings::s_maxSearchDepth);
+
+	// Lazy SMP: every helper searches the same root on its own copy of the position. They share nothing but the
+	// transposition table, which is how their work reaches the main thread.
+	std::vector<std::thread> helperThreads;
+	helperThreads.reserve(m_threads.size() - 1);
+	for (size_t threadIndex = 1; threadIndex < m_threads.size(); ++threadIndex)
+	{
+		SearchThread& helper = *m_threads[threadIndex];
+		helper.position->CopyPositionFrom(gameState);
+		helperThreads.emplace_back([this, &helper, maxDepth, searchDeadline]()
+		{
+			IterativeDeepening(helper, *helper.position, maxDepth, searchDeadline);
+		});
+	}
+
+	IterativeDeepening(mainThread, gameState, maxDepth, searchDeadline);
+
+	// Whatever the main thread settled on is the answer, the helpers can stop.
+	m_isStopRequested.store(true, std::memory_order_relaxed);
+	for (std::thread& helperThread : helperThreads)
+	{
+		helperThread.join();
+	}
+
+	if (mainThread.completedDepth > 0)
+	{
+		result.bestMove = mainThread.previousPrincipalVariation.front();
+		result.principalVariation = mainThread.previousPrincipalVariation;
+		result.score = mainThread.completedScore;
+		result.depth = mainThread.completedDepth;
+	}
+
+	for (const std::unique_ptr<SearchThread>& thread : m_threads)
+	{
+		result.nodes += thread->nodes;
+	}
+
+	spdlog::info("Search complete. player={} depth={} score={} nodes={} threads={}",
+		gameState.GetTurnPlayerId(), result.depth, result.score, result.nodes, m_threads.size());
+	return result;
+}
+
+void SearchEngine::IterativeDeepening(SearchThread& thread, GameState& gameState, int32_t maxDepth,
+	std::chrono::steady_clock::time_point searchDeadline)
+{
+	thread.rootJournalSize = gameState.GetUndoJournal().size();
+
+	const bool isMainThread = thread.threadIndex == 0;
+	for (int32_t depth = 1; depth <= maxDepth; ++depth)
+	{
+		if (!isMainThread && ShouldHelperSkipDepth(thread.threadIndex, depth))
+		{
+			continue;
+		}
+
+		if (isMainThread)
+		{
+			// The first iteration is always allowed to finish, so we have at least a 1 ply opinion on every move.
+			m_deadline = depth == 1 ? std::chrono::steady_clock::time_point::max() : searchDeadline;
+		}
+
+		const int32_t score = AlphaBeta(thread, gameState, depth, 0, -s_infiniteScore, s_infiniteScore);
+		if (m_isStopRequested.load(std::memory_order_relaxed))
+		{
+			// A partial iteration can't be trusted, the last completed one stands.
+			break;
+		}
+
+		thread.previousPrincipalVariation.assign(std::cbegin(thread.pvTable[0]),
+			std::cbegin(thread.pvTable[0]) + thread.pvLength[0]);
+		thread.completedScore = score;
+		thread.completedDepth = depth;
+
+		// Once a forced win or loss is found, searching deeper can't change the outcome.
+		if (isMainThread &&
+			(std::abs(score) >= s_forcedWinThreshold || std::chrono::steady_clock::now() >= searchDeadline))
+		{
+			break;
+		}
+	}
+}
+
+int32_t SearchEngine::Evaluate(const GameState& gameState, Identity playerId)
+{
+	const Identity opponentId = playerId == Identity::Red ? Identity::Black : Identity::Red;
+	return GetPlayerScore(gameState, playerId) - GetPlayerScore(gameState, opponentId);
+}
+
+int32_t SearchEngine::AlphaBeta(SearchThread& thread, GameState& gameState, int32_t depth, int32_t ply, int32_t alpha,
+	int32_t beta)
+{
+	thread.pvLength[ply] = ply;
+	++thread.nodes;
+
+	if (ShouldStop(thread))
+	{
+		return 0;
+	}
+
+	// Repeating a position means neither side could make progress, we call it a draw. That includes positions from
+	// earlier in the game, which count towards the game's repetition rule.
+	if (ply > 0 && (IsRepetition(thread, gameState) || gameState.HasPositionOccurredInGame()))
+	{
+		return 0;
+	}
+
+	const ZobristKey key = gameState.GetZobristKey();
+	TranspositionTable::ProbeResult tableEntry;
+	const bool isInTable = m_transpositionTable.Probe(key, tableEntry);
+	if (isInTable && ply > 0 && tableEntry.depth >= depth)
+	{
+		// We've already searched this position at least this deep, use that if its bound settles it.
+		const int32_t tableScore = FromTableScore(tableEntry.score, ply);
+		if (tableEntry.bound == TranspositionTable::Bound::Exact ||
+			(tableEntry.bound == TranspositionTable::Bound::Lower && tableScore >= beta) ||
+			(tableEntry.bound == TranspositionTable::Bound::Upper && tableScore <= alpha))
+		{
+			return tableScore;
+		}
+	}
+
+	// A player who can't move (no pieces left counts too) has lost. The masks tell us without generating anything.
+	const BitBoard& board = gameState.GetBoard();
+	const Identity turnPlayerId = gameState.GetTurnPlayerId();
+	if (!(MoveDiscoveryEngine::GetMovers(board, turnPlayerId) | MoveDiscoveryEngine::GetJumpers(board, turnPlayerId)))
+	{
+		return -(s_winScore - ply);
+	}
+
+	// Few enough pieces left, the tablebase knows the answer. Mid-chain positions aren't in it, the turn isn't over.
+	if (m_tablebase && ply > 0 && !gameState.HasPlayerTouchedPiece())
+	{
+		const int32_t pieceCount = gameState.GetMaterial(Identity::Red).GetPieceCount() +
+			gameState.GetMaterial(Identity::Black).GetPieceCount();
+		if (pieceCount <= m_tablebase->GetMaxPieceCount())
+		{
+			switch (m_tablebase->Probe(board, turnPlayerId, thread.tablebaseCache))
+			{
+			case TablebaseResult::Win:
+				return s_tablebaseWinScore + Evaluate(gameState, turnPlayerId);
+			case TablebaseResult::Loss:
+				return -s_tablebaseWinScore + Evaluate(gameState, turnPlayerId);
+			case TablebaseResult::Draw:
+				return 0;
+			default:
+				break;
+			}
+		}
+	}
+
+	if (ply >= s_maxPly - 1)
+	{
+		return Evaluate(gameState, turnPlayerId);
+	}
+
+	// Mid-exchange, the material count says nothing about who's winning. The leaf is searched until it's quiet.
+	if (depth <= 0)
+	{
+		thread.quiescenceNodesLeft = SearchSettings::s_maxQuiescenceNodes;
+		return Quiescence(thread, gameState, ply, alpha, beta);
+	}
+
+	// The transposition table's best move goes first, or failing that, the move from the previous iteration's
+	// principal variation.
+	PackedMove hashMove = isInTable ? tableEntry.bestMove : PackedMove{};
+	if (hashMove.IsNone() && ply < static_cast<int32_t>(thread.previousPrincipalVariation.size()))
+	{
+		hashMove = PackedMove::FromGameMove(thread.previousPrincipalVariation[ply]);
+	}
+
+	// The simple move that last refuted the opponent's move into this position. Mid-chain, that was our own capture.
+	const auto journal = gameState.GetUndoJournal();
+	PackedMove previousMove;
+	if (!journal.empty() && !gameState.HasPlayerTouchedPiece())
+	{
+		previousMove = PackedMove(journal.back().sourceSquare, journal.back().destSquare);
+	}
+	const PackedMove counterMove = thread.history.GetCounterMove(turnPlayerId, previousMove);
+	MovePicker movePicker(gameState, hashMove, thread.killerMoves[ply], counterMove, thread.history,
+		thread.moveBuffers[ply]);
+
+	const int32_t originalAlpha = alpha;
+	PackedMove bestMove;
+	int32_t bestScore = -s_infiniteScore;
+	while (const GameMove* nextMove = movePicker.GetNextMove())
+	{
+		const GameMove& move = *nextMove;
+		if (!move.IsCapture())
+		{
+			thread.history.RecordSearched(turnPlayerId, PackedMove::FromGameMove(move), depth);
+		}
+
+		gameState.MakeMove(move);
+		const int32_t score = -AlphaBeta(thread, gameState, depth - 1, ply + 1, -beta, -alpha);
+		gameState.UnmakeMove();
+
+		if (m_isStopRequested.load(std::memory_order_relaxed))
+		{
+			return 0;
+		}
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestMove = PackedMove::FromGameMove(move);
+		}
+
+		if (score > alpha)
+		{
+			alpha = score;
+
+			// This move is our new best line from here, followed by the best line found beneath it.
+			thread.pvTable[ply][ply] = move;
+			std::copy(std::cbegin(thread.pvTable[ply + 1]) + ply + 1,
+				std::cbegin(thread.pvTable[ply + 1]) + thread.pvLength[ply + 1],
+				std::begin(thread.pvTable[ply]) + ply + 1);
+			thread.pvLength[ply] = thread.pvLength[ply + 1];
+		}
+
+		if (alpha >= beta)
+		{
+			// The opponent will never allow this position, no need to look at the rest. A simple move that refutes
+			// it will likely refute its siblings too, so it's tried early at this ply from now on, and after the same
+			// opponent move anywhere.
+			if (!move.IsCapture())
+			{
+				StoreKillerMove(thread, ply, PackedMove::FromGameMove(move));
+				thread.history.RecordCutoff(turnPlayerId, PackedMove::FromGameMove(move), previousMove, depth);
+			}
+			break;
+		}
+	}
+
+	// Mid-chain positions share a key with the same position at the start of a turn, but not its moves.
+	if (!gameState.HasPlayerTouchedPiece())
+	{
+		const TranspositionTable::Bound bound = bestScore <= originalAlpha ? TranspositionTable::Bound::Upper :
+			(bestScore >= beta ? TranspositionTable::Bound::Lower : TranspositionTable::Bound::Exact);
+
+		// When nothing raised alpha, every move looked equally bad and the "best" one means nothing.
+		m_transpositionTable.Store(key, ToTableScore(bestScore, ply), depth, bound,
+			bound == TranspositionTable::Bound::Upper ? PackedMove{} : bestMove);
+	}
+
+	return bestScore;
+}
+
+int32_t SearchEngine::Quiescence(SearchThread& thread, GameState& gameState, int32_t ply, int32_t alpha, int32_t beta)
+{
+	thread.pvLength[ply] = ply;
+	++thread.nodes;
+
+	if (ShouldStop(thread))
+	{
+		return 0;
+	}
+
+	const BitBoard& board = gameState.GetBoard();
+	const Identity turnPlayerId = gameState.GetTurnPlayerId();
+	const uint32_t jumpers = MoveDiscoveryEngine::GetJumpers(board, turnPlayerId);
+	if (!(MoveDiscoveryEngine::GetMovers(board, turnPlayerId) | jumpers))
+	{
+		return -(s_winScore - ply);
+	}
+
+	// Nothing to take, the position is quiet and the evaluation can be trusted. When the budget or the ply limit runs
+	// out mid-exchange, the evaluation is the best we've got.
+	if (!jumpers || thread.quiescenceNodesLeft <= 0 || ply >= s_maxPly - 1)
+	{
+		return Evaluate(gameState, turnPlayerId);
+	}
+	--thread.quiescenceNodesLeft;
+
+	// Captures can't be undone, so nothing from here on can repeat an earlier position. The picker only hands out
+	// captures here, most pieces taken first.
+	MovePicker movePicker(gameState, PackedMove{}, thread.killerMoves[ply], PackedMove{}, thread.history,
+		thread.moveBuffers[ply]);
+
+	int32_t bestScore = -s_infiniteScore;
+	while (const GameMove* move = movePicker.GetNextMove())
+	{
+		gameState.MakeMove(*move);
+		const int32_t score = -Quiescence(thread, gameState, ply + 1, -beta, -alpha);
+		gameState.UnmakeMove();
+
+		if (m_isStopRequested.load(std::memory_order_relaxed))
+		{
+			return 0;
+		}
+
+		bestScore = std::max(bestScore, score);
+		alpha = std::max(alpha, score);
+		if (alpha >= beta)
+		{
+			break;
+		}
+	}
+
+	return bestScore;
+}
+
+void SearchEngine::StoreKillerMove(SearchThread& thread, int32_t ply, PackedMove move)
+{
+	// Newest first, and the same move never takes up both slots.
+	std::array<PackedMove, MovePicker::s_killerMoveCount>& killerMoves = thread.killerMoves[ply];
+	if (killerMoves.front() != move)
+	{
+		std::shift_right(killerMoves.begin(), killerMoves.end(), 1);
+		killerMoves.front() = move;
+	}
+}
+
+bool SearchEngine::IsRepetition(const SearchThread& thread, const GameState& gameState) const
+{
+	const auto journal = gameState.GetUndoJournal();
+	const ZobristKey key = gameState.GetZobristKey();
+
+	// Only positions with the same player to move can match, which is every other record.
+	for (int64_t index = static_cast<int64_t>(journal.size()) - 2; index >= static_cast<int64_t>(thread.rootJournalSize); index -= 2)
+	{
+		if (journal[index].previousZobristKey == key)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool SearchEngine::ShouldStop(const SearchThread& thread)
+{
+	if (m_isStopRequested.load(std::memory_order_relaxed))
+	{
+		return true;
+	}
+
+	// Only the main thread keeps time. Helpers stop when it tells them to.
+	if (thread.threadIndex == 0 && thread.nodes % SearchSettings::s_nodesPerTimeCheck == 0 &&
+		std::chrono::steady_clock::now() >= m_deadline)
+	{
+		m_isStopRequested.store(true, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,200 @@
+//---------------------------------------------------------------
+//
+// SearchEngine.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+#include "MovePicker.h"
+#include "OpeningBook.h"
+#include "PackedMove.h"
+#include "TablebaseProber.h"
+#include "TranspositionTable.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+class GameState;
+class SearchEngine
+{
+public:
+
+	// Limits for a single search. Whichever runs out first ends the search.
+	struct SearchLimits
+	{
+		// Iterative deepening stops after finishing this depth, in plies.
+		int32_t maxDepth = SearchSettings::s_defaultMaxDepth;
+
+		// Wall clock budget for the whole search.
+		std::chrono::milliseconds maxTime{ SearchSettings::s_defaultMaxTimeMilliseconds };
+	};
+
+	// Everything learned from the deepest fully completed iteration.
+	struct SearchResult
+	{
+		// The move to play. Only meaningful if hasMove is true.
+		GameMove bestMove;
+
+		// Score of bestMove from the searching player's point of view. Positive is good for them.
+		int32_t score = 0;
+
+		// Deepest iteration that was searched to completion.
+		int32_t depth = 0;
+
+		// Positions visited across every iteration, summed over every search thread.
+		uint64_t nodes = 0;
+
+		// The line both players are expected to play, starting with bestMove.
+		std::vector<GameMove> principalVariation;
+
+		// False if the turn player had nothing to play.
+		bool hasMove = false;
+
+		// True if bestMove came straight from the opening book, without searching.
+		bool isBookMove = false;
+	};
+
+	// Any score beyond this magnitude means somebody has a forced win. The winner's score shrinks by one per ply so
+	// that quicker wins (and slower losses) are preferred.
+	static constexpr int32_t s_winScore = 30000;
+	static constexpr int32_t s_infiniteScore = s_winScore + 1;
+
+	SearchEngine(const SearchEngine& other) = delete;
+	SearchEngine& operator=(const SearchEngine& other) = delete;
+	SearchEngine(SearchEngine&& other) noexcept = delete;
+	SearchEngine& operator=(SearchEngine&& other) noexcept = delete;
+
+	// The transposition table is allocated up front at the given size, and shared by every search thread.
+	SearchEngine(size_t transpositionTableMegabytes, int32_t threadCount);
+	~SearchEngine();
+
+	// Finds the best whole turn for the turn player of the given state. The state is searched in place with
+	// MakeMove/UnmakeMove and is left exactly as it was found. If a capture chain is already underway, only the
+	// touched piece's continuations are considered.
+	SearchResult Search(GameState& gameState, const SearchLimits& limits);
+
+	// Asks a running search to wrap up. Safe to call from any thread; the search returns its last completed iteration.
+	void Stop() { m_isStopRequested.store(true, std::memory_order_relaxed); }
+
+	// Sets how many threads search together (Lazy SMP), clamped to [1, s_maxThreadCount]. Not safe mid-search.
+	void SetThreadCount(int32_t threadCount);
+	int32_t GetThreadCount() const { return static_cast<int32_t>(m_threads.size()); }
+
+	// Endgame databases to settle positions from once few enough pieces are left, or nullptr for none. The prober
+	// isn't owned, and has to outlive the engine or be unset first. Not safe mid-search.
+	void SetTablebase(const TablebaseProber* tablebase) { m_tablebase = tablebase; }
+
+	// Opening book to play from while it knows the position, or nullptr for none. Same ownership rules as the
+	// tablebase.
+	void SetOpeningBook(const OpeningBook* openingBook) { m_openingBook = openingBook; }
+
+	// Scores the position from the point of view of the given player. Positive is good for them.
+	static int32_t Evaluate(const GameState& gameState, Identity playerId);
+
+private:
+
+	// Deepest ply the search can reach, including the root.
+	static constexpr int32_t s_maxPly = SearchSettings::s_maxSearchDepth + 1;
+
+	// Everything one search thread owns. Thread 0 is the main thread: it searches the caller's state, watches the
+	// clock and decides the result. Helper threads search a private copy of the position and only exist to fill the
+	// shared transposition table with results the main thread can use.
+	struct SearchThread
+	{
+		// Which thread this is. Helpers use it to stagger the depths they search.
+		int32_t threadIndex = 0;
+
+		// The position helpers make moves on. Empty for the main thread.
+		std::unique_ptr<GameState> position;
+
+		// Triangular principal variation table. Row n holds the best line found from ply n.
+		std::vector<std::array<GameMove, s_maxPly>> pvTable;
+		std::array<int32_t, s_maxPly> pvLength{};
+
+		// The principal variation of the last completed iteration, tried first on the next one.
+		std::vector<GameMove> previousPrincipalVariation;
+
+		// One move list per ply, kept around between searches so generating moves doesn't allocate.
+		std::vector<std::vector<GameMove>> moveBuffers;
+
+		// Simple moves that most recently caused a beta cutoff at each ply, newest first.
+		std::array<std::array<PackedMove, MovePicker::s_killerMoveCount>, s_maxPly> killerMoves{};
+
+		// History, butterfly and counter move tables for ordering the simple moves nothing else has a guess for.
+		MoveHistory history;
+
+		// Tablebase blocks this thread probed recently. Each thread has its own, so probes never wait on each other.
+		TablebaseProber::BlockCache tablebaseCache;
+
+		// Positions the current quiescence search may still visit.
+		int32_t quiescenceNodesLeft = 0;
+
+		// Where the undo journal stood when the search started. Entries past this are part of the search path.
+		size_t rootJournalSize = 0;
+
+		// Positions this thread visited in the current search.
+		uint64_t nodes = 0;
+
+		// Score and depth of the deepest iteration this thread completed.
+		int32_t completedScore = 0;
+		int32_t completedDepth = 0;
+	};
+
+	// Runs iterative deepening on one thread until it reaches maxDepth, or the stop flag goes up. Only the main
+	// thread ends the search early, on time or on finding a forced win.
+	void IterativeDeepening(SearchThread& thread, GameState& gameState, int32_t maxDepth,
+		std::chrono::steady_clock::time_point searchDeadline);
+
+	// Negamax alpha-beta. Returns the score of the position from the point of view of the side to move.
+	int32_t AlphaBeta(SearchThread& thread, GameState& gameState, int32_t depth, int32_t ply, int32_t alpha, int32_t beta);
+
+	// Plays out the captures pending at a leaf, so positions are only ever evaluated once they're quiet. Captures are
+	// mandatory, so the side to move can only stand pat (take the static evaluation) when it has none.
+	int32_t Quiescence(SearchThread& thread, GameState& gameState, int32_t ply, int32_t alpha, int32_t beta);
+
+	// Remembers a simple move that caused a beta cutoff at the given ply, so MovePicker tries it early there.
+	static void StoreKillerMove(SearchThread& thread, int32_t ply, PackedMove move);
+
+	// Returns true if the position the state is in now already occurred earlier in the search path.
+	bool IsRepetition(const SearchThread& thread, const GameState& gameState) const;
+
+	// Reads the clock every so often on the main thread, and raises the stop flag once time is up.
+	bool ShouldStop(const SearchThread& thread);
+
+	// Results shared across iterations, searches and threads, keyed by position.
+	TranspositionTable m_transpositionTable;
+
+	// Probed for positions with few enough pieces. Null if there are no tablebases.
+	const TablebaseProber* m_tablebase = nullptr;
+
+	// Consulted before searching the root. Null if there's no book.
+	const OpeningBook* m_openingBook = nullptr;
+
+	// Picks between book moves, so games don't all follow the same line.
+	std::mt19937_64 m_bookMoveRandom{ std::random_device{}() };
+
+	// Every search thread, the main thread first.
+	std::vector<std::unique_ptr<SearchThread>> m_threads;
+
+	// The search gives up once the clock passes this point. Only the main thread reads it.
+	std::chrono::steady_clock::time_point m_deadline;
+
+	// Raised when time runs out, or when someone asks us to stop. Every thread watches it.
+	std::atomic<bool> m_isStopRequested = false;
+};
+
+//===============================================================
+
+}
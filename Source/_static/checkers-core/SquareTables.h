@@ -0,0 +1,195 @@
+//---------------------------------------------------------------
+//
+// SquareTables.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "BoardGeometry.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+// Where a piece on each playable square ends up after one step or one jump along each diagonal, and every square
+// along each diagonal for pieces that fly, worked out at compile time from the geometry. Move generation reads its
+// neighbours out of these instead of doing coordinate maths and edge checks on every probe. Off the board is
+// s_invalidSquare in the square tables and an empty mask in the mask tables, so a mask lookup can be used as is,
+// with no check first. Directions are in BasicBitBoard::Step's order.
+template <typename Geometry>
+struct BasicSquareTables
+{
+	using SquareMask = typename Geometry::SquareMask;
+	using DirectionSquares = std::array<int8_t, BitBoard::s_directionCount>;
+	using DirectionMasks = std::array<SquareMask, BitBoard::s_directionCount>;
+
+	// The squares along one diagonal, nearest first. A diagonal is never as long as the board, so there's always an
+	// s_invalidSquare after the last one.
+	using RaySquares = std::array<int8_t, Geometry::s_boardSize>;
+
+	static_assert(GameplaySettings::s_kingDirections.size() == BitBoard::s_directionCount,
+		"Kings go every direction, so their directions index the tables.");
+
+	// Square the given number of steps away, per square and direction.
+	static constexpr std::array<DirectionSquares, Geometry::s_playableSquareCount> BuildDirectionSquares(int32_t distance)
+	{
+		std::array<DirectionSquares, Geometry::s_playableSquareCount> table{};
+		for (int32_t square = 0; square < Geometry::s_playableSquareCount; ++square)
+		{
+			for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+			{
+				const glm::ivec2 destCoord = Geometry::ToCoordFromSquare(square) +
+					distance * GameplaySettings::s_kingDirections[direction];
+				table[square][direction] = static_cast<int8_t>(Geometry::ToSquareFromCoord(destCoord));
+			}
+		}
+		return table;
+	}
+
+	static constexpr std::array<DirectionMasks, Geometry::s_playableSquareCount> BuildDirectionMasks(
+		const std::array<DirectionSquares, Geometry::s_playableSquareCount>& squares)
+	{
+		std::array<DirectionMasks, Geometry::s_playableSquareCount> table{};
+		for (int32_t square = 0; square < Geometry::s_playableSquareCount; ++square)
+		{
+			for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+			{
+				const int32_t destSquare = squares[square][direction];
+				table[square][direction] = destSquare == GameBoardStatics::s_invalidSquare ?
+					0 : Geometry::GetSquareMask(destSquare);
+			}
+		}
+		return table;
+	}
+
+	// Square one step away, per square and direction.
+	static constexpr std::array<DirectionSquares, Geometry::s_playableSquareCount> s_stepSquares =
+		BuildDirectionSquares(GameplaySettings::s_moveDistance);
+
+	// Square one jump away, per square and direction. The square jumped over is the step square.
+	static constexpr std::array<DirectionSquares, Geometry::s_playableSquareCount> s_jumpSquares =
+		BuildDirectionSquares(GameplaySettings::s_captureDistance);
+
+	static constexpr std::array<DirectionMasks, Geometry::s_playableSquareCount> s_stepMasks =
+		BuildDirectionMasks(s_stepSquares);
+
+	static constexpr std::array<DirectionMasks, Geometry::s_playableSquareCount> s_jumpMasks =
+		BuildDirectionMasks(s_jumpSquares);
+
+	// Every square along each diagonal, nearest first, per square and direction. Walked by flying kings.
+	static constexpr std::array<std::array<RaySquares, BitBoard::s_directionCount>, Geometry::s_playableSquareCount>
+		s_raySquares = []
+	{
+		std::array<std::array<RaySquares, BitBoard::s_directionCount>, Geometry::s_playableSquareCount> table{};
+		for (int32_t square = 0; square < Geometry::s_playableSquareCount; ++square)
+		{
+			for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+			{
+				table[square][direction].fill(static_cast<int8_t>(GameBoardStatics::s_invalidSquare));
+				int32_t raySquare = s_stepSquares[square][direction];
+				for (int32_t distance = 0; raySquare != GameBoardStatics::s_invalidSquare; ++distance)
+				{
+					table[square][direction][distance] = static_cast<int8_t>(raySquare);
+					raySquare = s_stepSquares[raySquare][direction];
+				}
+			}
+		}
+		return table;
+	}();
+
+	// The same diagonals as masks.
+	static constexpr std::array<DirectionMasks, Geometry::s_playableSquareCount> s_rayMasks = []
+	{
+		std::array<DirectionMasks, Geometry::s_playableSquareCount> table{};
+		for (int32_t square = 0; square < Geometry::s_playableSquareCount; ++square)
+		{
+			for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+			{
+				for (const int8_t raySquare : s_raySquares[square][direction])
+				{
+					if (raySquare != GameBoardStatics::s_invalidSquare)
+					{
+						table[square][direction] |= Geometry::GetSquareMask(raySquare);
+					}
+				}
+			}
+		}
+		return table;
+	}();
+
+	// Half open range of the directions a piece may go in. Up comes first in BitBoard::Step's order, so a piece's
+	// directions are always contiguous.
+	struct DirectionRange
+	{
+		int32_t first = 0;
+		int32_t last = 0;
+	};
+
+	// Returns the directions the piece moves in. Pawns only move forward.
+	static constexpr DirectionRange GetDirectionRange(const Piece& piece)
+	{
+		const bool isPawn = piece.pieceType == PieceType::Pawn;
+		return {
+			isPawn && piece.identity == Identity::Black ? BitBoard::s_firstDownDirection : 0,
+			isPawn && piece.identity == Identity::Red ? BitBoard::s_firstDownDirection : BitBoard::s_directionCount };
+	}
+
+	// Returns every square the piece could step to from the given square, board permitting.
+	static constexpr SquareMask GetStepMasks(int32_t square, DirectionRange directions)
+	{
+		SquareMask steps = 0;
+		for (int32_t direction = directions.first; direction < directions.last; ++direction)
+		{
+			steps |= s_stepMasks[square][direction];
+		}
+		return steps;
+	}
+
+	// Returns the square jumped over going from sourceSquare to destSquare, or s_invalidSquare if that isn't a jump.
+	static constexpr int32_t GetJumpedSquare(int32_t sourceSquare, int32_t destSquare)
+	{
+		for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+		{
+			if (s_jumpSquares[sourceSquare][direction] == destSquare)
+			{
+				return s_stepSquares[sourceSquare][direction];
+			}
+		}
+		return GameBoardStatics::s_invalidSquare;
+	}
+
+	// Returns true if the tables agree with the bit board's shifts everywhere.
+	static constexpr bool MatchesBitBoardSteps()
+	{
+		using Board = BasicBitBoard<Geometry>;
+		for (int32_t square = 0; square < Geometry::s_playableSquareCount; ++square)
+		{
+			for (int32_t direction = 0; direction < BitBoard::s_directionCount; ++direction)
+			{
+				const SquareMask stepMask = Board::Step(direction, Board::GetSquareMask(square));
+				if (s_stepMasks[square][direction] != stepMask ||
+					s_jumpMasks[square][direction] != Board::Step(direction, stepMask))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+};
+
+// The tables the game plays with.
+using SquareTables = BasicSquareTables<GameplaySettings::Rules::Geometry>;
+
+static_assert(SquareTables::MatchesBitBoardSteps(), "The square tables and BitBoard have to share a layout.");
+static_assert(BasicSquareTables<BoardGeometry<10>>::MatchesBitBoardSteps(), "10x10 has to share the layout too.");
+
+//===============================================================
+
+}
@@ -0,0 +1,308 @@
+//---------------------------------------------------------------
+//
+// Tablebase.cpp
+//
+
+#include "Tablebase.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace Checkers {
+
+//===============================================================
+
+static constexpr int32_t s_squareCount = GameplaySettings::s_playableSquareCount;
+
+// Pawns never stand on their own king row, they'd have been crowned.
+static constexpr int32_t s_pawnSquareCount = s_squareCount - BitBoard::s_squaresPerRow;
+
+// Binomial coefficients, n choose k, for every n and k a board can need.
+static constexpr auto s_binomials = []
+{
+	std::array<std::array<uint64_t, s_squareCount + 1>, s_squareCount + 1> table{};
+	for (int32_t n = 0; n <= s_squareCount; ++n)
+	{
+		table[n][0] = 1;
+		for (int32_t k = 1; k <= n; ++k)
+		{
+			table[n][k] = table[n - 1][k - 1] + (k < n ? table[n - 1][k] : 0);
+		}
+	}
+	return table;
+}();
+
+// Ranks the pieces as a combination of the universe's squares, in colexicographic order: each piece counts for
+// the combinations that only use squares before it.
+static uint64_t RankPieces(uint32_t pieces, uint32_t universe)
+{
+#ifdef DEBUG
+	assert((pieces & ~universe) == 0);
+#endif
+
+	uint64_t rank = 0;
+	for (int32_t pieceIndex = 1; pieces; pieces &= pieces - 1, ++pieceIndex)
+	{
+		const uint32_t squaresBefore = (pieces & (~pieces + 1)) - 1;
+		rank += s_binomials[std::popcount(universe & squaresBefore)][pieceIndex];
+	}
+	return rank;
+}
+
+// The inverse of RankPieces. Returns false if the rank needs more squares than the universe has.
+static bool UnrankPieces(uint64_t rank, int32_t pieceCount, uint32_t universe, uint32_t& outPieces)
+{
+	const int32_t universeSize = std::popcount(universe);
+	outPieces = 0;
+
+	// The last piece is the one furthest into the universe, and takes the biggest share of the rank.
+	int32_t position = s_squareCount;
+	for (int32_t pieceIndex = pieceCount; pieceIndex > 0; --pieceIndex)
+	{
+		do
+		{
+			--position;
+		} while (s_binomials[position][pieceIndex] > rank);
+
+		if (position >= universeSize)
+		{
+			return false;
+		}
+		rank -= s_binomials[position][pieceIndex];
+
+		uint32_t squares = universe;
+		for (int32_t skipped = 0; skipped < position; ++skipped)
+		{
+			squares &= squares - 1;
+		}
+		outPieces |= squares & (~squares + 1);
+	}
+	return true;
+}
+
+//===============================================================
+
+MaterialSignature MaterialSignature::FromBoard(const BitBoard& board)
+{
+	MaterialSignature signature;
+	signature.redPawnCount = static_cast<int8_t>(std::popcount(board.red & ~board.kings));
+	signature.redKingCount = static_cast<int8_t>(std::popcount(board.red & board.kings));
+	signature.blackPawnCount = static_cast<int8_t>(std::popcount(board.black & ~board.kings));
+	signature.blackKingCount = static_cast<int8_t>(std::popcount(board.black & board.kings));
+	return signature;
+}
+
+bool MaterialSignature::IsValid() const
+{
+	return std::ranges::all_of(std::array{ redPawnCount, redKingCount, blackPawnCount, blackKingCount },
+		[](int8_t count) { return count >= 0 && count <= GameplaySettings::Rules::s_pieceCount; });
+}
+
+std::string MaterialSignature::ToString() const
+{
+	return fmt::format("{}p{}k-{}p{}k", redPawnCount, redKingCount, blackPawnCount, blackKingCount);
+}
+
+//===============================================================
+
+TablebaseIndex::TablebaseIndex(const MaterialSignature& signature)
+	: m_signature(signature)
+{
+	const int32_t pawnCount = signature.GetPawnCount();
+	m_redPawnRankCount = s_binomials[s_pawnSquareCount][signature.redPawnCount];
+	m_blackPawnRankCount = s_binomials[s_pawnSquareCount][signature.blackPawnCount];
+	m_redKingRankCount = s_binomials[s_squareCount - pawnCount][signature.redKingCount];
+	m_blackKingRankCount = s_binomials[s_squareCount - pawnCount - signature.redKingCount][signature.blackKingCount];
+	m_positionCount = m_redPawnRankCount * m_blackPawnRankCount * m_redKingRankCount * m_blackKingRankCount *
+		GameplaySettings::s_playerCount;
+}
+
+uint64_t TablebaseIndex::GetIndex(const BitBoard& board, Identity turnPlayerId) const
+{
+#ifdef DEBUG
+	assert(MaterialSignature::FromBoard(board) == m_signature);
+#endif
+
+	const uint32_t redPawns = board.red & ~board.kings;
+	const uint32_t blackPawns = board.black & ~board.kings;
+	const uint32_t redKings = board.red & board.kings;
+	const uint32_t blackKings = board.black & board.kings;
+
+	const uint32_t redPawnSquares = BitBoard::s_allSquaresMask & ~BitBoard::GetKingRowMask(Identity::Red);
+	const uint32_t blackPawnSquares = BitBoard::s_allSquaresMask & ~BitBoard::GetKingRowMask(Identity::Black) & ~redPawns;
+	const uint32_t redKingSquares = BitBoard::s_allSquaresMask & ~(redPawns | blackPawns);
+	const uint32_t blackKingSquares = redKingSquares & ~redKings;
+
+	uint64_t index = RankPieces(redPawns, redPawnSquares);
+	index = index * m_blackPawnRankCount + RankPieces(blackPawns, blackPawnSquares);
+	index = index * m_redKingRankCount + RankPieces(redKings, redKingSquares);
+	index = index * m_blackKingRankCount + RankPieces(blackKings, blackKingSquares);
+	return index * GameplaySettings::s_playerCount + (turnPlayerId == Identity::Red ? 0 : 1);
+}
+
+bool TablebaseIndex::TryGetPosition(uint64_t index, BitBoard& outBoard, Identity& outTurnPlayerId) const
+{
+	outTurnPlayerId = index % GameplaySettings::s_playerCount == 0 ? Identity::Red : Identity::Black;
+	index /= GameplaySettings::s_playerCount;
+	const uint64_t blackKingRank = index % m_blackKingRankCount;
+	index /= m_blackKingRankCount;
+	const uint64_t redKingRank = index % m_redKingRankCount;
+	index /= m_redKingRankCount;
+	const uint64_t blackPawnRank = index % m_blackPawnRankCount;
+	const uint64_t redPawnRank = index / m_blackPawnRankCount;
+
+	// Same universes as GetIndex, built up as the pieces that narrow them down are found.
+	uint32_t redPawns = 0;
+	uint32_t blackPawns = 0;
+	uint32_t redKings = 0;
+	uint32_t blackKings = 0;
+	const uint32_t redPawnSquares = BitBoard::s_allSquaresMask & ~BitBoard::GetKingRowMask(Identity::Red);
+	if (!UnrankPieces(redPawnRank, m_signature.redPawnCount, redPawnSquares, redPawns))
+	{
+		return false;
+	}
+
+	const uint32_t blackPawnSquares = BitBoard::s_allSquaresMask & ~BitBoard::GetKingRowMask(Identity::Black) & ~redPawns;
+	if (!UnrankPieces(blackPawnRank, m_signature.blackPawnCount, blackPawnSquares, blackPawns))
+	{
+		return false;
+	}
+
+	const uint32_t redKingSquares = BitBoard::s_allSquaresMask & ~(redPawns | blackPawns);
+	if (!UnrankPieces(redKingRank, m_signature.redKingCount, redKingSquares, redKings) ||
+		!UnrankPieces(blackKingRank, m_signature.blackKingCount, redKingSquares & ~redKings, blackKings))
+	{
+		return false;
+	}
+
+	outBoard.red = redPawns | redKings;
+	outBoard.black = blackPawns | blackKings;
+	outBoard.kings = redKings | blackKings;
+	return true;
+}
+
+//===============================================================
+
+// Repeats shorter than this cost more as a run than they do inside a literal.
+static constexpr uint64_t s_minRunLength = 3;
+
+static void WriteVarint(uint64_t value, std::vector<uint8_t>& outBytes)
+{
+	do
+	{
+		const uint8_t lowBits = value & 0x7F;
+		value >>= 7;
+		outBytes.push_back(value ? (lowBits | 0x80) : lowBits);
+	} while (value);
+}
+
+static bool ReadVarint(std::span<const uint8_t> bytes, size_t& byteIndex, uint64_t& outValue)
+{
+	outValue = 0;
+	for (int32_t shift = 0; shift <= 63; shift += 7)
+	{
+		if (byteIndex >= bytes.size())
+		{
+			return false;
+		}
+		outValue |= static_cast<uint64_t>(bytes[byteIndex] & 0x7F) << shift;
+		if (!(bytes[byteIndex++] & 0x80))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void TablebaseBlockCodec::Compress(std::span<const uint8_t> packedResults, uint64_t firstIndex, uint64_t count,
+	std::vector<uint8_t>& outBytes)
+{
+#ifdef DEBUG
+	assert(firstIndex % PackedTablebaseResults::s_resultsPerByte == 0);
+#endif
+
+	const std::span<const uint8_t> blockBytes = packedResults.subspan(
+		firstIndex / PackedTablebaseResults::s_resultsPerByte, PackedTablebaseResults::GetByteCount(count));
+
+	// Bytes that didn't repeat enough to be a run pile up here until the next run, or the end, writes them out.
+	size_t literalStart = 0;
+	const auto writeLiteral = [&](size_t literalEnd)
+	{
+		if (literalEnd > literalStart)
+		{
+			WriteVarint(((literalEnd - literalStart) << 1) | 1, outBytes);
+			outBytes.insert(outBytes.end(), blockBytes.begin() + literalStart, blockBytes.begin() + literalEnd);
+		}
+	};
+
+	size_t runStart = 0;
+	while (runStart < blockBytes.size())
+	{
+		size_t runEnd = runStart + 1;
+		while (runEnd < blockBytes.size() && blockBytes[runEnd] == blockBytes[runStart])
+		{
+			++runEnd;
+		}
+
+		if (runEnd - runStart >= s_minRunLength)
+		{
+			writeLiteral(runStart);
+			WriteVarint((runEnd - runStart) << 1, outBytes);
+			outBytes.push_back(blockBytes[runStart]);
+			literalStart = runEnd;
+		}
+		runStart = runEnd;
+	}
+	writeLiteral(blockBytes.size());
+}
+
+bool TablebaseBlockCodec::Decompress(std::span<const uint8_t> bytes, uint64_t count, std::span<uint8_t> outPackedResults)
+{
+	const uint64_t blockByteCount = PackedTablebaseResults::GetByteCount(count);
+	if (outPackedResults.size() < blockByteCount)
+	{
+		return false;
+	}
+
+	uint64_t outIndex = 0;
+	size_t byteIndex = 0;
+	while (outIndex < blockByteCount)
+	{
+		uint64_t header = 0;
+		if (!ReadVarint(bytes, byteIndex, header))
+		{
+			return false;
+		}
+
+		const uint64_t length = header >> 1;
+		const bool isLiteral = header & 1;
+		const uint64_t sourceLength = isLiteral ? length : 1;
+		if (length == 0 || length > blockByteCount - outIndex || sourceLength > bytes.size() - byteIndex)
+		{
+			return false;
+		}
+
+		if (isLiteral)
+		{
+			std::copy_n(bytes.begin() + byteIndex, length, outPackedResults.begin() + outIndex);
+		}
+		else
+		{
+			std::fill_n(outPackedResults.begin() + outIndex, length, bytes[byteIndex]);
+		}
+		byteIndex += sourceLength;
+		outIndex += length;
+	}
+	return byteIndex == bytes.size();
+}
+
+//===============================================================
+
+}
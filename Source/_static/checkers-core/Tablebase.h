@@ -0,0 +1,149 @@
+//---------------------------------------------------------------
+//
+// Tablebase.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+
+#include <compare>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+// The game theoretic value of an endgame position, from the point of view of the player to move, assuming both
+// sides play perfectly. Draws include every position that only ever goes round in circles.
+enum class TablebaseResult : uint8_t
+{
+	// Nothing is known, or no position has this index.
+	Unknown,
+	Win,
+	Loss,
+	Draw,
+};
+
+// How many of each kind of piece are on the board. Every position with the same signature lives in the same table,
+// and a move can only ever go to a table with fewer pieces, fewer pawns, or back to this one.
+struct MaterialSignature
+{
+	int8_t redPawnCount = 0;
+	int8_t redKingCount = 0;
+	int8_t blackPawnCount = 0;
+	int8_t blackKingCount = 0;
+
+	auto operator<=>(const MaterialSignature& other) const = default;
+
+	static MaterialSignature FromBoard(const BitBoard& board);
+
+	// False if any count is negative or more than a side starts with. Signatures read from files can hold anything.
+	bool IsValid() const;
+
+	int32_t GetPieceCount() const { return redPawnCount + redKingCount + blackPawnCount + blackKingCount; }
+	int32_t GetPawnCount() const { return redPawnCount + blackPawnCount; }
+
+	// Red first, e.g. "2p1k-0p2k". Used to name the table's file.
+	std::string ToString() const;
+};
+
+// Numbers every position of one material signature, both players to move, densely enough to keep a result per
+// index. Each kind of piece is ranked as a combination of the squares it could be on, in this order: red pawns
+// anywhere but their king row, black pawns anywhere but theirs that red pawns left free, then red kings and black
+// kings on whatever is left. Where the two pawn sets overlap, some black pawn ranks go unused, which costs a little
+// space but keeps indexing to a handful of popcounts.
+class TablebaseIndex
+{
+public:
+	TablebaseIndex() = default;
+	explicit TablebaseIndex(const MaterialSignature& signature);
+
+	const MaterialSignature& GetSignature() const { return m_signature; }
+
+	// Indices run from 0 up to this, some of them unused.
+	uint64_t GetPositionCount() const { return m_positionCount; }
+
+	// Returns the index of the position. The board has to match the signature.
+	uint64_t GetIndex(const BitBoard& board, Identity turnPlayerId) const;
+
+	// Fills in the position at the index. Returns false if the index is one no position uses.
+	bool TryGetPosition(uint64_t index, BitBoard& outBoard, Identity& outTurnPlayerId) const;
+
+private:
+	MaterialSignature m_signature;
+
+	// How many ranks each kind of piece has. The index is a mixed radix number of them, with the turn player last.
+	uint64_t m_redPawnRankCount = 1;
+	uint64_t m_blackPawnRankCount = 1;
+	uint64_t m_redKingRankCount = 1;
+	uint64_t m_blackKingRankCount = 1;
+
+	uint64_t m_positionCount = 0;
+};
+
+// Results are kept two bits each, four to a byte, lowest bits first.
+struct PackedTablebaseResults
+{
+	static constexpr uint64_t s_resultsPerByte = 4;
+
+	static constexpr uint64_t GetByteCount(uint64_t positionCount)
+	{
+		return (positionCount + s_resultsPerByte - 1) / s_resultsPerByte;
+	}
+
+	static TablebaseResult Get(std::span<const uint8_t> packedResults, uint64_t index)
+	{
+		const int32_t shift = static_cast<int32_t>(index % s_resultsPerByte) * 2;
+		return static_cast<TablebaseResult>((packedResults[index / s_resultsPerByte] >> shift) & 0x3);
+	}
+
+	static void Set(std::span<uint8_t> packedResults, uint64_t index, TablebaseResult result)
+	{
+		const int32_t shift = static_cast<int32_t>(index % s_resultsPerByte) * 2;
+		uint8_t& packedByte = packedResults[index / s_resultsPerByte];
+		packedByte = static_cast<uint8_t>((packedByte & ~(0x3 << shift)) | (static_cast<uint8_t>(result) << shift));
+	}
+};
+
+// Compresses blocks of packed results. Endgame tables are mostly long stretches of the same result, or the same
+// pattern of results for the two players to move, which shows up as the same packed byte over and over. A block is
+// stored as a series of runs and literals, each starting with a LEB128 varint of its byte count shifted up one bit:
+// a clear low bit means a run, followed by the byte it repeats, and a set one means that many bytes copied as is.
+struct TablebaseBlockCodec
+{
+	// Appends the compressed form of count packed results, starting at firstIndex, to outBytes. firstIndex has to
+	// start a byte.
+	static void Compress(std::span<const uint8_t> packedResults, uint64_t firstIndex, uint64_t count,
+		std::vector<uint8_t>& outBytes);
+
+	// Decompresses a block of count results into outPackedResults. Returns false if the block is malformed.
+	static bool Decompress(std::span<const uint8_t> bytes, uint64_t count, std::span<uint8_t> outPackedResults);
+};
+
+// What a table file starts with. After it comes one uint64_t offset per block, plus one for the end of the last
+// block, counted from the end of the offsets. The compressed blocks follow.
+struct TablebaseFileHeader
+{
+	static constexpr uint32_t s_magic = 0x42544B43; // "CKTB"
+	static constexpr uint32_t s_version = 2;
+	static constexpr const char* s_fileExtension = ".cdb";
+
+	uint32_t magic = s_magic;
+	uint32_t version = s_version;
+	MaterialSignature signature;
+	uint32_t positionsPerBlock = 0;
+	uint64_t positionCount = 0;
+
+	uint64_t GetBlockCount() const { return (positionCount + positionsPerBlock - 1) / positionsPerBlock; }
+};
+static_assert(sizeof(TablebaseFileHeader) == 24, "The header is written as is, it can't have padding.");
+
+//===============================================================
+
+}
@@ -0,0 +1,366 @@
+//---------------------------------------------------------------
+//
+// TablebaseGenerator.cpp
+//
+
+#include "TablebaseGenerator.h"
+
+#include "GameSettings.h"
+#include "MoveDiscoveryEngine.h"
+#include "SquareTables.h"
+#include "WorkStealingThreadPool.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <fstream>
+
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+namespace Checkers {
+
+//===============================================================
+
+// Layout of a position's result byte while its table is being built. The low bits hold a TablebaseResult. Every
+// result is flagged with the parity of the pass that resolved it, so the next pass can find what's new without
+// mistaking what it resolves itself for it.
+static constexpr uint8_t s_resultMask = 0x3;
+static constexpr uint8_t s_resolvedInEvenPassFlag = 0x4;
+static constexpr uint8_t s_resolvedInOddPassFlag = 0x8;
+
+// Marks indices no position uses, so passes skip them.
+static constexpr uint8_t s_unusedIndex = 0xFF;
+
+static uint8_t GetResolvedInPassFlag(int32_t passIndex)
+{
+	return passIndex % 2 == 0 ? s_resolvedInEvenPassFlag : s_resolvedInOddPassFlag;
+}
+
+static constexpr int32_t s_maxPiecesPerPlayer = GameplaySettings::Rules::s_pieceCount;
+
+//---------------------------------------------------------------
+
+TablebaseGenerator::TablebaseGenerator(int32_t threadCount)
+	: m_threadPool(std::make_unique<WorkStealingThreadPool>(threadCount))
+{
+	m_workerMoveBuffers.resize(m_threadPool->GetThreadCount());
+}
+
+TablebaseGenerator::~TablebaseGenerator() = default;
+
+std::vector<MaterialSignature> TablebaseGenerator::GetSignaturesUpTo(int32_t maxPieceCount)
+{
+	std::vector<MaterialSignature> signatures;
+	for (int32_t redCount = 1; redCount <= s_maxPiecesPerPlayer; ++redCount)
+	{
+		for (int32_t blackCount = 1; blackCount <= s_maxPiecesPerPlayer && redCount + blackCount <= maxPieceCount;
+			++blackCount)
+		{
+			for (int32_t redPawnCount = 0; redPawnCount <= redCount; ++redPawnCount)
+			{
+				for (int32_t blackPawnCount = 0; blackPawnCount <= blackCount; ++blackPawnCount)
+				{
+					MaterialSignature& signature = signatures.emplace_back();
+					signature.redPawnCount = static_cast<int8_t>(redPawnCount);
+					signature.redKingCount = static_cast<int8_t>(redCount - redPawnCount);
+					signature.blackPawnCount = static_cast<int8_t>(blackPawnCount);
+					signature.blackKingCount = static_cast<int8_t>(blackCount - blackPawnCount);
+				}
+			}
+		}
+	}
+
+	// Captures lose pieces and promotions lose pawns, so this puts every table after the ones it leads to.
+	std::ranges::stable_sort(signatures, {}, [](const MaterialSignature& signature)
+	{
+		return std::pair(signature.GetPieceCount(), signature.GetPawnCount());
+	});
+	return signatures;
+}
+
+const TablebaseGenerator::Table& TablebaseGenerator::Generate(const MaterialSignature& signature,
+	TableStats& outStats)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	auto table = std::make_unique<Table>();
+	table->index = TablebaseIndex(signature);
+	const uint64_t positionCount = table->index.GetPositionCount();
+
+	BuildState state;
+	state.results.assign(positionCount, static_cast<uint8_t>(TablebaseResult::Unknown));
+	state.unrefutedMoveCounts.assign(positionCount, 0);
+
+	outStats = {};
+	outStats.positionCount = positionCount;
+	outStats.passCount = 1;
+	uint64_t resolvedCount = RunFirstPass(table->index, state);
+	while (resolvedCount > 0)
+	{
+		resolvedCount = RunRetrogradePass(table->index, state, outStats.passCount++);
+	}
+
+	table->packedResults.resize(PackedTablebaseResults::GetByteCount(positionCount));
+	for (uint64_t positionIndex = 0; positionIndex < positionCount; ++positionIndex)
+	{
+		TablebaseResult result = static_cast<TablebaseResult>(state.results[positionIndex] & s_resultMask);
+		if (state.results[positionIndex] == s_unusedIndex)
+		{
+			result = TablebaseResult::Unknown;
+		}
+		else if (result == TablebaseResult::Unknown)
+		{
+			// Nothing ever forced this one either way.
+			result = TablebaseResult::Draw;
+		}
+
+		outStats.winCount += result == TablebaseResult::Win;
+		outStats.lossCount += result == TablebaseResult::Loss;
+		outStats.drawCount += result == TablebaseResult::Draw;
+		PackedTablebaseResults::Set(table->packedResults, positionIndex, result);
+	}
+
+	outStats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	spdlog::info("Tablebase generated. signature={} positions={} wins={} losses={} draws={} passes={} elapsedMs={}",
+		signature.ToString(), positionCount, outStats.winCount, outStats.lossCount, outStats.drawCount,
+		outStats.passCount, outStats.elapsed.count());
+
+	const Table& finishedTable = *table;
+	m_tables[signature] = std::move(table);
+	return finishedTable;
+}
+
+const TablebaseGenerator::Table* TablebaseGenerator::FindTable(const MaterialSignature& signature) const
+{
+	const auto tableIt = m_tables.find(signature);
+	return tableIt != m_tables.end() ? tableIt->second.get() : nullptr;
+}
+
+TablebaseResult TablebaseGenerator::GetResult(const BitBoard& board, Identity turnPlayerId) const
+{
+	if (!board.GetPiecesForId(turnPlayerId))
+	{
+		return TablebaseResult::Loss;
+	}
+
+	const Table* table = FindTable(MaterialSignature::FromBoard(board));
+	return table ? table->GetResult(table->index.GetIndex(board, turnPlayerId)) : TablebaseResult::Unknown;
+}
+
+bool TablebaseGenerator::WriteTable(const Table& table, const std::filesystem::path& directory)
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(directory, errorCode);
+
+	const std::filesystem::path path = directory /
+		(table.index.GetSignature().ToString() + TablebaseFileHeader::s_fileExtension);
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		spdlog::error("Couldn't open tablebase file for writing. path={}", path.string());
+		return false;
+	}
+
+	TablebaseFileHeader header;
+	header.signature = table.index.GetSignature();
+	header.positionsPerBlock = TablebaseSettings::s_positionsPerBlock;
+	header.positionCount = table.index.GetPositionCount();
+
+	const uint64_t blockCount = header.GetBlockCount();
+	std::vector<uint64_t> blockOffsets;
+	blockOffsets.reserve(blockCount + 1);
+	std::vector<uint8_t> blocks;
+	for (uint64_t blockIndex = 0; blockIndex < blockCount; ++blockIndex)
+	{
+		const uint64_t firstIndex = blockIndex * header.positionsPerBlock;
+		blockOffsets.push_back(blocks.size());
+		TablebaseBlockCodec::Compress(table.packedResults, firstIndex,
+			std::min<uint64_t>(header.positionsPerBlock, header.positionCount - firstIndex), blocks);
+	}
+	blockOffsets.push_back(blocks.size());
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(blockOffsets.data()), blockOffsets.size() * sizeof(uint64_t));
+	file.write(reinterpret_cast<const char*>(blocks.data()), blocks.size());
+	if (!file)
+	{
+		spdlog::error("Couldn't write tablebase file. path={}", path.string());
+		return false;
+	}
+	return true;
+}
+
+template <typename PositionVisitor>
+uint64_t TablebaseGenerator::ForEachPosition(uint64_t positionCount, PositionVisitor visitPosition)
+{
+	std::atomic<uint64_t> resolvedCount = 0;
+
+	std::vector<WorkStealingThreadPool::Task> tasks;
+	tasks.reserve((positionCount + TablebaseSettings::s_positionsPerTask - 1) / TablebaseSettings::s_positionsPerTask);
+	for (uint64_t firstIndex = 0; firstIndex < positionCount; firstIndex += TablebaseSettings::s_positionsPerTask)
+	{
+		const uint64_t lastIndex = std::min(firstIndex + TablebaseSettings::s_positionsPerTask, positionCount);
+		tasks.emplace_back([&visitPosition, &resolvedCount, firstIndex, lastIndex](int32_t workerIndex)
+		{
+			uint64_t taskResolvedCount = 0;
+			for (uint64_t positionIndex = firstIndex; positionIndex < lastIndex; ++positionIndex)
+			{
+				taskResolvedCount += visitPosition(positionIndex, workerIndex);
+			}
+			resolvedCount.fetch_add(taskResolvedCount, std::memory_order_relaxed);
+		});
+	}
+
+	m_threadPool->RunBatch(std::move(tasks));
+	return resolvedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t TablebaseGenerator::RunFirstPass(const TablebaseIndex& index, BuildState& state)
+{
+	const uint8_t resolvedFlag = GetResolvedInPassFlag(0);
+	return ForEachPosition(index.GetPositionCount(), [&](uint64_t positionIndex, int32_t workerIndex) -> uint64_t
+	{
+		// Nothing else touches this position in the first pass.
+		uint8_t& result = state.results[positionIndex];
+		BitBoard board;
+		Identity turnPlayerId = Identity::Neutral;
+		if (!index.TryGetPosition(positionIndex, board, turnPlayerId))
+		{
+			result = s_unusedIndex;
+			return 0;
+		}
+
+		std::vector<GameMove>& moves = m_workerMoveBuffers[workerIndex];
+		moves.clear();
+		MoveDiscoveryEngine::GenerateGameMoves(board, turnPlayerId, moves);
+
+		const Identity opponentId = turnPlayerId == Identity::Red ? Identity::Black : Identity::Red;
+		uint8_t unrefutedMoveCount = 0;
+		for (const GameMove& move : moves)
+		{
+			BitBoard childBoard = board;
+			childBoard.ApplyMove(move.sourceSquare, move.destSquare, move.capturedSquares);
+
+			// Moves within the table are what the later passes find out about.
+			if (MaterialSignature::FromBoard(childBoard) == index.GetSignature())
+			{
+				++unrefutedMoveCount;
+				continue;
+			}
+
+			const TablebaseResult childResult = GetResult(childBoard, opponentId);
+
+#ifdef DEBUG
+			// Tables have to be built in GetSignaturesUpTo's order, otherwise this one is missing.
+			assert(childResult != TablebaseResult::Unknown);
+#endif
+
+			if (childResult == TablebaseResult::Loss)
+			{
+				result = static_cast<uint8_t>(TablebaseResult::Win) | resolvedFlag;
+				return 1;
+			}
+
+			// A move to a drawn position never loses, so the count can't ever reach zero.
+			if (childResult != TablebaseResult::Win)
+			{
+				++unrefutedMoveCount;
+			}
+		}
+
+		state.unrefutedMoveCounts[positionIndex] = unrefutedMoveCount;
+		if (unrefutedMoveCount == 0)
+		{
+			result = static_cast<uint8_t>(TablebaseResult::Loss) | resolvedFlag;
+			return 1;
+		}
+		return 0;
+	});
+}
+
+uint64_t TablebaseGenerator::RunRetrogradePass(const TablebaseIndex& index, BuildState& state, int32_t passIndex)
+{
+	const uint8_t previousResolvedFlag = GetResolvedInPassFlag(passIndex - 1);
+	const uint8_t resolvedFlag = GetResolvedInPassFlag(passIndex);
+	return ForEachPosition(index.GetPositionCount(), [&](uint64_t positionIndex, int32_t) -> uint64_t
+	{
+		// Other tasks resolve predecessors in this table while we read it. A result only ever goes from unknown to
+		// final once, so compare-exchange is enough to make sure each one is counted once.
+		std::atomic_ref<uint8_t> result(state.results[positionIndex]);
+		const uint8_t resultByte = result.load(std::memory_order_relaxed);
+		if (resultByte == s_unusedIndex || !(resultByte & previousResolvedFlag))
+		{
+			return 0;
+		}
+		result.fetch_and(static_cast<uint8_t>(~previousResolvedFlag), std::memory_order_relaxed);
+
+		BitBoard board;
+		Identity turnPlayerId = Identity::Neutral;
+		index.TryGetPosition(positionIndex, board, turnPlayerId);
+		const bool isLost = (resultByte & s_resultMask) == static_cast<uint8_t>(TablebaseResult::Loss);
+
+		// Walk back through every simple move the opponent could have made to get here. Those are the only moves that
+		// stay in the table: captures take a piece, and promotions turn a pawn into a king.
+		const Identity previousPlayerId = turnPlayerId == Identity::Red ? Identity::Black : Identity::Red;
+		const uint32_t empty = board.GetEmpty();
+		uint64_t resolvedCount = 0;
+		for (uint32_t movedPieces = board.GetPiecesForId(previousPlayerId); movedPieces; movedPieces &= movedPieces - 1)
+		{
+			const int32_t destSquare = std::countr_zero(movedPieces);
+			const Piece piece = board.GetPieceAtSquare(destSquare);
+
+			// Back along the directions the piece moves in, which for a pawn are the ones it can't move in.
+			const SquareTables::DirectionRange directions = SquareTables::GetDirectionRange(piece);
+			for (int32_t direction = BitBoard::s_directionCount - directions.last;
+				direction < BitBoard::s_directionCount - directions.first; ++direction)
+			{
+				if (!(SquareTables::s_stepMasks[destSquare][direction] & empty))
+				{
+					continue;
+				}
+
+				BitBoard previousBoard = board;
+				previousBoard.SetPieceAtSquare(destSquare, GameBoardStatics::s_emptyPiece);
+				previousBoard.SetPieceAtSquare(SquareTables::s_stepSquares[destSquare][direction], piece);
+
+				// Captures are mandatory, so a simple move can't have been played with one on offer.
+				if (MoveDiscoveryEngine::GetJumpers(previousBoard, previousPlayerId))
+				{
+					continue;
+				}
+
+				const uint64_t previousIndex = index.GetIndex(previousBoard, previousPlayerId);
+				std::atomic_ref<uint8_t> previousResult(state.results[previousIndex]);
+				uint8_t expectedResult = static_cast<uint8_t>(TablebaseResult::Unknown);
+				if (previousResult.load(std::memory_order_relaxed) != expectedResult)
+				{
+					continue;
+				}
+
+				// Moving here wins for them if we've lost, and is one more of their moves refuted if we've won.
+				if (isLost)
+				{
+					const uint8_t wonResult = static_cast<uint8_t>(TablebaseResult::Win) | resolvedFlag;
+					resolvedCount += previousResult.compare_exchange_strong(expectedResult, wonResult,
+						std::memory_order_relaxed);
+				}
+				else if (std::atomic_ref<uint8_t>(state.unrefutedMoveCounts[previousIndex]).fetch_sub(1,
+					std::memory_order_relaxed) == 1)
+				{
+					const uint8_t lostResult = static_cast<uint8_t>(TablebaseResult::Loss) | resolvedFlag;
+					resolvedCount += previousResult.compare_exchange_strong(expectedResult, lostResult,
+						std::memory_order_relaxed);
+				}
+			}
+		}
+		return resolvedCount;
+	});
+}
+
+//===============================================================
+
+}
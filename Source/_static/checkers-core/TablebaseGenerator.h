@@ -0,0 +1,129 @@
+//---------------------------------------------------------------
+//
+// TablebaseGenerator.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameTypes.h"
+#include "Tablebase.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+class WorkStealingThreadPool;
+
+// Builds win/loss/draw endgame databases by retrograde analysis, one material signature at a time, from the fewest
+// pieces up. Moves come from MoveDiscoveryEngine and are played with BitBoard::ApplyMove, so captures and promotion
+// work exactly like they do in a game.
+//
+// The first pass looks at every position's moves once. A position whose player can't move is lost, and one with a
+// capture or promotion into a finished table that's lost for the opponent is won. Every other position counts the
+// moves it has that aren't known to lose yet. From then on, each pass walks back from the positions the last one
+// resolved, through the simple moves that lead to them: a predecessor that can move to a lost position is won, and
+// one whose last move is found to lose is lost. Whatever never resolves can only go round in circles, and is drawn.
+// Every pass is split into chunks of the index space that run in parallel across the thread pool.
+class TablebaseGenerator
+{
+public:
+
+	// A finished database.
+	struct Table
+	{
+		TablebaseIndex index;
+
+		// Results in index order, see PackedTablebaseResults. Indices no position uses are Unknown.
+		std::vector<uint8_t> packedResults;
+
+		TablebaseResult GetResult(uint64_t positionIndex) const
+		{
+			return PackedTablebaseResults::Get(packedResults, positionIndex);
+		}
+	};
+
+	// What building one table found.
+	struct TableStats
+	{
+		uint64_t positionCount = 0;
+		uint64_t winCount = 0;
+		uint64_t lossCount = 0;
+		uint64_t drawCount = 0;
+
+		// Passes it took, counting the last one that resolved nothing.
+		int32_t passCount = 0;
+
+		std::chrono::milliseconds elapsed{ 0 };
+	};
+
+	TablebaseGenerator(const TablebaseGenerator& other) = delete;
+	TablebaseGenerator& operator=(const TablebaseGenerator& other) = delete;
+	TablebaseGenerator(TablebaseGenerator&& other) noexcept = delete;
+	TablebaseGenerator& operator=(TablebaseGenerator&& other) noexcept = delete;
+
+	// Passes run on a work-stealing pool of the given size.
+	TablebaseGenerator(int32_t threadCount);
+	~TablebaseGenerator();
+
+	// Every signature with both players on the board and at most maxPieceCount pieces, in an order they can be built
+	// in: fewer pieces first, then fewer pawns.
+	static std::vector<MaterialSignature> GetSignaturesUpTo(int32_t maxPieceCount);
+
+	// Builds the table for the signature. Every table a capture or promotion could lead to must be built already.
+	const Table& Generate(const MaterialSignature& signature, TableStats& outStats);
+
+	// Returns the finished table for the signature, or nullptr if it hasn't been built.
+	const Table* FindTable(const MaterialSignature& signature) const;
+
+	// Looks the position up in the finished tables. A player with no pieces left has lost, and positions with no
+	// table are Unknown.
+	TablebaseResult GetResult(const BitBoard& board, Identity turnPlayerId) const;
+
+	// Writes the table into the directory, compressed and named after its signature (see TablebaseFileHeader).
+	// Returns false if it couldn't be written.
+	static bool WriteTable(const Table& table, const std::filesystem::path& directory);
+
+private:
+
+	// Everything kept about each position while its table is being built, a byte each so threads can update them
+	// without touching their neighbours.
+	struct BuildState
+	{
+		// The result in the low bits, see s_resultMask, plus a flag for the pass that resolved it.
+		std::vector<uint8_t> results;
+
+		// How many of the position's moves aren't known to lose. Reaching zero means the position is lost.
+		std::vector<uint8_t> unrefutedMoveCounts;
+	};
+
+	// Looks at every position's moves. Returns how many positions it resolved.
+	uint64_t RunFirstPass(const TablebaseIndex& index, BuildState& state);
+
+	// Resolves what it can from the positions the previous pass resolved. Returns how many positions it resolved.
+	uint64_t RunRetrogradePass(const TablebaseIndex& index, BuildState& state, int32_t passIndex);
+
+	// Splits the index space into tasks and calls visitPosition(positionIndex, workerIndex) for every index across
+	// the pool. visitPosition returns how many positions it resolved, and this returns the total.
+	template <typename PositionVisitor>
+	uint64_t ForEachPosition(uint64_t positionCount, PositionVisitor visitPosition);
+
+	std::unique_ptr<WorkStealingThreadPool> m_threadPool;
+
+	// One move list per pool thread, indexed by worker index.
+	std::vector<std::vector<GameMove>> m_workerMoveBuffers;
+
+	// Every finished table. Pointers to them stay good as more are added.
+	std::map<MaterialSignature, std::unique_ptr<Table>> m_tables;
+};
+
+//===============================================================
+
+}
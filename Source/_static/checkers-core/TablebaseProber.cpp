@@ -0,0 +1,161 @@
+//---------------------------------------------------------------
+//
+// TablebaseProber.cpp
+//
+
+#include "TablebaseProber.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Checkers {
+
+//===============================================================
+
+// Blocks start on whole bytes of packed results, so a block can be decompressed on its own.
+static_assert(TablebaseSettings::s_positionsPerBlock % PackedTablebaseResults::s_resultsPerByte == 0);
+
+//---------------------------------------------------------------
+
+TablebaseProber::TablebaseProber() = default;
+TablebaseProber::~TablebaseProber() = default;
+
+int32_t TablebaseProber::Open(const std::filesystem::path& directory)
+{
+	int32_t openedCount = 0;
+	std::error_code errorCode;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, errorCode))
+	{
+		if (entry.path().extension() != TablebaseFileHeader::s_fileExtension)
+		{
+			continue;
+		}
+
+		auto table = std::make_unique<MappedTable>();
+		if (!table->file.Open(entry.path()))
+		{
+			spdlog::warn("Couldn't map tablebase file. path={}", entry.path().string());
+			continue;
+		}
+
+		// Everything a probe relies on is checked here, so probing never has to.
+		const std::span<const uint8_t> data = table->file.GetData();
+		TablebaseFileHeader header;
+		if (data.size() >= sizeof(header))
+		{
+			std::memcpy(&header, data.data(), sizeof(header));
+		}
+		if (data.size() < sizeof(header) || header.magic != TablebaseFileHeader::s_magic ||
+			header.version != TablebaseFileHeader::s_version ||
+			header.positionsPerBlock != TablebaseSettings::s_positionsPerBlock || !header.signature.IsValid() ||
+			header.signature.GetPieceCount() > TablebaseSettings::s_maxPieceCount)
+		{
+			spdlog::warn("Skipping tablebase file that isn't one we can read. path={}", entry.path().string());
+			continue;
+		}
+
+		table->index = TablebaseIndex(header.signature);
+		const uint64_t offsetsSize = (header.GetBlockCount() + 1) * sizeof(uint64_t);
+		if (header.positionCount != table->index.GetPositionCount() || data.size() - sizeof(header) < offsetsSize)
+		{
+			spdlog::warn("Skipping tablebase file that doesn't match its signature. path={}", entry.path().string());
+			continue;
+		}
+
+		table->blockOffsets = data.subspan(sizeof(header), offsetsSize);
+		table->blocks = data.subspan(sizeof(header) + offsetsSize);
+		if (GetBlockOffset(*table, header.GetBlockCount()) != table->blocks.size())
+		{
+			spdlog::warn("Skipping truncated tablebase file. path={}", entry.path().string());
+			continue;
+		}
+
+		m_maxPieceCount = std::max(m_maxPieceCount, header.signature.GetPieceCount());
+		m_tables[header.signature] = std::move(table);
+		++openedCount;
+	}
+
+	spdlog::info("Tablebases opened. directory={} tables={} maxPieces={}", directory.string(), openedCount,
+		m_maxPieceCount);
+	return openedCount;
+}
+
+TablebaseResult TablebaseProber::Probe(const BitBoard& board, Identity turnPlayerId, BlockCache& cache) const
+{
+	if (!board.GetPiecesForId(turnPlayerId))
+	{
+		return TablebaseResult::Loss;
+	}
+
+	const auto tableIt = m_tables.find(MaterialSignature::FromBoard(board));
+	if (tableIt == m_tables.end())
+	{
+		return TablebaseResult::Unknown;
+	}
+
+	const MappedTable& table = *tableIt->second;
+	const uint64_t positionIndex = table.index.GetIndex(board, turnPlayerId);
+	const uint64_t blockIndex = positionIndex / TablebaseSettings::s_positionsPerBlock;
+	const uint64_t indexInBlock = positionIndex % TablebaseSettings::s_positionsPerBlock;
+	++cache.m_useTime;
+
+	BlockCache::Entry* oldestEntry = &cache.m_entries.front();
+	for (BlockCache::Entry& entry : cache.m_entries)
+	{
+		if (entry.table == &table && entry.blockIndex == blockIndex)
+		{
+			entry.lastUseTime = cache.m_useTime;
+			return PackedTablebaseResults::Get(entry.packedResults, indexInBlock);
+		}
+		if (entry.lastUseTime < oldestEntry->lastUseTime)
+		{
+			oldestEntry = &entry;
+		}
+	}
+
+	if (!LoadBlock(table, blockIndex, *oldestEntry))
+	{
+		return TablebaseResult::Unknown;
+	}
+	oldestEntry->lastUseTime = cache.m_useTime;
+	return PackedTablebaseResults::Get(oldestEntry->packedResults, indexInBlock);
+}
+
+uint64_t TablebaseProber::GetBlockOffset(const MappedTable& table, uint64_t boundaryIndex)
+{
+	// The offsets follow the header, so they're only as aligned as its size makes them. Copying doesn't care.
+	uint64_t offset = 0;
+	std::memcpy(&offset, table.blockOffsets.data() + boundaryIndex * sizeof(uint64_t), sizeof(offset));
+	return offset;
+}
+
+bool TablebaseProber::LoadBlock(const MappedTable& table, uint64_t blockIndex, BlockCache::Entry& outEntry)
+{
+	outEntry.table = nullptr;
+
+	const uint64_t blockStart = GetBlockOffset(table, blockIndex);
+	const uint64_t blockEnd = GetBlockOffset(table, blockIndex + 1);
+	if (blockStart > blockEnd || blockEnd > table.blocks.size())
+	{
+		return false;
+	}
+
+	const uint64_t firstIndex = blockIndex * TablebaseSettings::s_positionsPerBlock;
+	const uint64_t count = std::min<uint64_t>(TablebaseSettings::s_positionsPerBlock,
+		table.index.GetPositionCount() - firstIndex);
+	if (!TablebaseBlockCodec::Decompress(table.blocks.subspan(blockStart, blockEnd - blockStart), count,
+		outEntry.packedResults))
+	{
+		return false;
+	}
+
+	outEntry.table = &table;
+	outEntry.blockIndex = blockIndex;
+	return true;
+}
+
+//===============================================================
+
+}
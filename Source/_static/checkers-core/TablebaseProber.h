@@ -0,0 +1,100 @@
+//---------------------------------------------------------------
+//
+// TablebaseProber.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+#include "MappedFile.h"
+#include "Tablebase.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+
+namespace Checkers {
+
+//===============================================================
+
+// Answers win/loss/draw questions from the endgame databases TablebaseGenerator writes. Table files are memory
+// mapped rather than read, so opening them is instant however big they are, and processes probing the same files
+// share one copy in the page cache. Only the compressed blocks a probe lands in are ever read. Once open, the prober
+// never changes, so any number of threads can probe it at once without locking, each with a BlockCache of its own.
+class TablebaseProber
+{
+public:
+
+	// The blocks one thread decompressed most recently. When it's full, the least recently used block makes way.
+	class BlockCache
+	{
+	private:
+		friend class TablebaseProber;
+
+		struct Entry
+		{
+			// Which table and block this holds. No table means the entry is empty.
+			const void* table = nullptr;
+			uint64_t blockIndex = 0;
+
+			// When the block was last probed, on the cache's own clock. Empty entries are always the oldest.
+			uint64_t lastUseTime = 0;
+
+			std::array<uint8_t, PackedTablebaseResults::GetByteCount(TablebaseSettings::s_positionsPerBlock)> packedResults;
+		};
+
+		std::array<Entry, TablebaseSettings::s_cachedBlocksPerThread> m_entries{};
+
+		// Ticks once per probe.
+		uint64_t m_useTime = 0;
+	};
+
+	TablebaseProber(const TablebaseProber& other) = delete;
+	TablebaseProber& operator=(const TablebaseProber& other) = delete;
+	TablebaseProber(TablebaseProber&& other) noexcept = delete;
+	TablebaseProber& operator=(TablebaseProber&& other) noexcept = delete;
+
+	TablebaseProber();
+	~TablebaseProber();
+
+	// Maps every table file in the directory. Files that don't check out are skipped. Returns how many were mapped.
+	// Not safe while anyone is probing.
+	int32_t Open(const std::filesystem::path& directory);
+
+	// Most pieces on the board in any mapped table. Positions with more are never worth probing.
+	int32_t GetMaxPieceCount() const { return m_maxPieceCount; }
+
+	// Looks the position up. A player with no pieces left has lost, and positions with no mapped table are Unknown.
+	TablebaseResult Probe(const BitBoard& board, Identity turnPlayerId, BlockCache& cache) const;
+
+private:
+
+	// One mapped table file.
+	struct MappedTable
+	{
+		TablebaseIndex index;
+		MappedFile file;
+
+		// Where each block starts in blocks, plus where the last one ends. Stored as uint64_t, see TablebaseFileHeader.
+		std::span<const uint8_t> blockOffsets;
+		std::span<const uint8_t> blocks;
+	};
+
+	// Returns the offset of the given block boundary in the table's blocks.
+	static uint64_t GetBlockOffset(const MappedTable& table, uint64_t boundaryIndex);
+
+	// Decompresses the block into the cache entry. Returns false if the block is malformed.
+	static bool LoadBlock(const MappedTable& table, uint64_t blockIndex, BlockCache::Entry& outEntry);
+
+	std::map<MaterialSignature, std::unique_ptr<MappedTable>> m_tables;
+
+	int32_t m_maxPieceCount = 0;
+};
+
+//===============================================================
+
+}
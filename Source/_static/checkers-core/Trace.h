@@ -0,0 +1,94 @@
+//---------------------------------------------------------------
+//
+// Trace.h
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include <spdlog/spdlog.h>
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+#include <spdlog/fmt/ranges.h>
+
+// Trace points are chatty logs in code that runs every move or every node. Unlike a plain spdlog call, a disabled
+// trace point is compiled out: its arguments are never evaluated or formatted, so it costs nothing at runtime.
+//
+// Each subsystem can be switched on or off at build time by defining its flag to 1 or 0. Unless told otherwise,
+// debug builds trace everything and release builds trace nothing.
+//   CHECKERS_TRACE_MOVEGEN  Move discovery.
+//   CHECKERS_TRACE_STATE    Game state changes: turns, moves, repetition counts.
+//   CHECKERS_TRACE_INPUT    Command parsing and execution.
+//   CHECKERS_TRACE_DISPLAY  Console output.
+
+#ifdef DEBUG
+#define CHECKERS_TRACE_DEFAULT 1
+#else
+#define CHECKERS_TRACE_DEFAULT 0
+#endif
+
+#ifndef CHECKERS_TRACE_MOVEGEN
+#define CHECKERS_TRACE_MOVEGEN CHECKERS_TRACE_DEFAULT
+#endif
+
+#ifndef CHECKERS_TRACE_STATE
+#define CHECKERS_TRACE_STATE CHECKERS_TRACE_DEFAULT
+#endif
+
+#ifndef CHECKERS_TRACE_INPUT
+#define CHECKERS_TRACE_INPUT CHECKERS_TRACE_DEFAULT
+#endif
+
+#ifndef CHECKERS_TRACE_DISPLAY
+#define CHECKERS_TRACE_DISPLAY CHECKERS_TRACE_DEFAULT
+#endif
+
+namespace Checkers {
+namespace Trace {
+
+//===============================================================
+
+enum class Subsystem : int32_t
+{
+	MoveGen,
+	State,
+	Input,
+	Display
+};
+
+// Whether trace points for the subsystem were compiled in.
+constexpr bool IsEnabled(Subsystem subsystem)
+{
+	switch (subsystem)
+	{
+	case Subsystem::MoveGen:
+		return CHECKERS_TRACE_MOVEGEN != 0;
+	case Subsystem::State:
+		return CHECKERS_TRACE_STATE != 0;
+	case Subsystem::Input:
+		return CHECKERS_TRACE_INPUT != 0;
+	case Subsystem::Display:
+		return CHECKERS_TRACE_DISPLAY != 0;
+	default:
+		return false;
+	}
+}
+
+//===============================================================
+
+}
+}
+
+// Logs at debug level if the subsystem's trace points are compiled in. Disabled call sites are still type checked,
+// so they can't rot, but generate no code.
+// Usage: CHECKERS_TRACE(State, "Player turn change. old={} new={}", oldPlayer, newPlayer);
+#define CHECKERS_TRACE(subsystem, ...) \
+	do \
+	{ \
+		if constexpr (::Checkers::Trace::IsEnabled(::Checkers::Trace::Subsystem::subsystem)) \
+		{ \
+			spdlog::debug(__VA_ARGS__); \
+		} \
+	} while (false)
@@ -0,0 +1,164 @@
+//---------------------------------------------------------------
+//
+// TranspositionTable.cpp
+//
+
+#include "TranspositionTable.h"
+
+#include "PackedMove.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace Checkers {
+
+//===============================================================
+
+// Layout of an entry's data word, low bits first.
+//   score           16 bits, signed
+//   depth            8 bits
+//   bound            2 bits
+//   generation       4 bits
+//   best move       16 bits, a PackedMove
+// The top 18 bits are unused.
+static constexpr int32_t s_depthShift = 16;
+static constexpr int32_t s_boundShift = 24;
+static constexpr int32_t s_generationShift = 26;
+static constexpr int32_t s_bestMoveShift = 30;
+
+static constexpr uint64_t s_scoreMask = 0xFFFF;
+static constexpr uint64_t s_depthMask = 0xFF;
+static constexpr uint64_t s_boundMask = 0x3;
+static constexpr uint64_t s_generationMask = 0xF;
+static constexpr uint64_t s_bestMoveMask = 0xFFFF;
+
+static uint64_t PackData(int32_t score, int32_t depth, TranspositionTable::Bound bound, uint32_t generation,
+	PackedMove bestMove)
+{
+	uint64_t data = static_cast<uint64_t>(static_cast<uint16_t>(score));
+	data |= (static_cast<uint64_t>(depth) & s_depthMask) << s_depthShift;
+	data |= static_cast<uint64_t>(bound) << s_boundShift;
+	data |= static_cast<uint64_t>(generation) << s_generationShift;
+
+	// No move is stored as an empty PackedMove, which no real move looks like.
+	data |= static_cast<uint64_t>(bestMove.GetBits()) << s_bestMoveShift;
+	return data;
+}
+
+static TranspositionTable::Bound GetBound(uint64_t data)
+{
+	return static_cast<TranspositionTable::Bound>((data >> s_boundShift) & s_boundMask);
+}
+
+static int32_t GetDepth(uint64_t data)
+{
+	return static_cast<int32_t>((data >> s_depthShift) & s_depthMask);
+}
+
+static uint32_t GetGeneration(uint64_t data)
+{
+	return static_cast<uint32_t>((data >> s_generationShift) & s_generationMask);
+}
+
+//---------------------------------------------------------------
+
+TranspositionTable::TranspositionTable(size_t sizeMegabytes)
+{
+	static constexpr size_t s_bytesPerMegabyte = 1024 * 1024;
+	const size_t requestedBucketCount = std::max<size_t>(sizeMegabytes * s_bytesPerMegabyte / sizeof(Bucket), 1);
+	m_bucketCount = std::bit_floor(requestedBucketCount);
+	m_buckets = std::make_unique<Bucket[]>(m_bucketCount);
+
+	spdlog::info("Transposition table allocated. requestedMegabytes={} bytes={} buckets={}",
+		sizeMegabytes, GetSizeBytes(), m_bucketCount);
+}
+
+TranspositionTable::~TranspositionTable() = default;
+
+bool TranspositionTable::Probe(ZobristKey key, ProbeResult& outResult) const
+{
+	const Bucket& bucket = m_buckets[key & (m_bucketCount - 1)];
+	for (const Entry& entry : bucket.entries)
+	{
+		const uint64_t data = entry.data.load(std::memory_order_relaxed);
+		const uint64_t keyXorData = entry.keyXorData.load(std::memory_order_relaxed);
+
+		// A torn write (or a different position) won't XOR back to our key.
+		if ((keyXorData ^ data) != key || GetBound(data) == Bound::None)
+		{
+			continue;
+		}
+
+		outResult.score = static_cast<int16_t>(data & s_scoreMask);
+		outResult.depth = GetDepth(data);
+		outResult.bound = GetBound(data);
+		outResult.bestMove = PackedMove::FromBits(static_cast<uint16_t>((data >> s_bestMoveShift) & s_bestMoveMask));
+		return true;
+	}
+	return false;
+}
+
+void TranspositionTable::Store(ZobristKey key, int32_t score, int32_t depth, Bound bound, PackedMove bestMove)
+{
+	Bucket& bucket = m_buckets[key & (m_bucketCount - 1)];
+
+	// Overwrite our own entry if it's here, otherwise the entry that's least worth keeping: old searches go first,
+	// then shallow results.
+	Entry* replaced = nullptr;
+	int32_t replacedWorth = std::numeric_limits<int32_t>::max();
+	for (Entry& entry : bucket.entries)
+	{
+		const uint64_t data = entry.data.load(std::memory_order_relaxed);
+		if ((entry.keyXorData.load(std::memory_order_relaxed) ^ data) == key)
+		{
+			// Keep a deeper result for the same position unless it's stale, but still remember a new best move: it's
+			// what the latest search would try first here.
+			const bool isDeeperEntry = GetDepth(data) > depth && GetGeneration(data) == m_generation;
+			if (isDeeperEntry)
+			{
+				if (!bestMove.IsNone())
+				{
+					const uint64_t newData = (data & ~(s_bestMoveMask << s_bestMoveShift)) |
+						(static_cast<uint64_t>(bestMove.GetBits()) << s_bestMoveShift);
+					entry.data.store(newData, std::memory_order_relaxed);
+					entry.keyXorData.store(key ^ newData, std::memory_order_relaxed);
+				}
+				return;
+			}
+			replaced = &entry;
+			break;
+		}
+
+		static constexpr int32_t s_staleGenerationPenalty = 256;
+		const int32_t worth = GetBound(data) == Bound::None ? std::numeric_limits<int32_t>::min() :
+			GetDepth(data) - (GetGeneration(data) == m_generation ? 0 : s_staleGenerationPenalty);
+		if (worth < replacedWorth)
+		{
+			replacedWorth = worth;
+			replaced = &entry;
+		}
+	}
+
+	const uint64_t data = PackData(score, depth, bound, m_generation, bestMove);
+	replaced->data.store(data, std::memory_order_relaxed);
+	replaced->keyXorData.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear()
+{
+	for (size_t bucketIndex = 0; bucketIndex < m_bucketCount; ++bucketIndex)
+	{
+		for (Entry& entry : m_buckets[bucketIndex].entries)
+		{
+			entry.data.store(0, std::memory_order_relaxed);
+			entry.keyXorData.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+//===============================================================
+
+}
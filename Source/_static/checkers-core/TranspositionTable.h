@@ -0,0 +1,116 @@
+//---------------------------------------------------------------
+//
+// TranspositionTable.h
+//
+
+#pragma once
+
+#include "GameTypes.h"
+#include "PackedMove.h"
+#include "Zobrist.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Checkers {
+
+//===============================================================
+
+// A fixed size cache of search results keyed by Zobrist key. Checkers reaches the same position through different
+// move orders all the time (king shuffles especially), and this lets the search reuse what it already learned.
+//
+// Every entry is two 64 bit words: the packed data, and the key XORed with that data. Writes and reads are plain
+// relaxed atomic stores and loads with no locking. If two threads race on an entry and a reader sees one thread's
+// data with another thread's key word, the XOR no longer reproduces the key and the entry is treated as a miss.
+class TranspositionTable
+{
+public:
+
+	// How a stored score relates to the position's true score.
+	enum class Bound : uint8_t
+	{
+		// Empty entry.
+		None = 0,
+
+		// The score is exact, it came from a full window.
+		Exact,
+
+		// The true score is at least this much, the search failed high (beta cutoff).
+		Lower,
+
+		// The true score is at most this much, nothing raised alpha.
+		Upper
+	};
+
+	// What a successful probe hands back.
+	struct ProbeResult
+	{
+		// The score as stored, relative to the probed position.
+		int32_t score = 0;
+
+		// Remaining depth the score was searched to.
+		int32_t depth = 0;
+
+		Bound bound = Bound::None;
+
+		// Only the endpoints of the move are stored. Compare it against packed generated moves to find the real
+		// thing. None if the entry had no best move (every move failed low).
+		PackedMove bestMove;
+	};
+
+	TranspositionTable(const TranspositionTable& other) = delete;
+	TranspositionTable& operator=(const TranspositionTable& other) = delete;
+	TranspositionTable(TranspositionTable&& other) noexcept = default;
+	TranspositionTable& operator=(TranspositionTable&& other) noexcept = default;
+
+	// Allocates the largest power of two number of buckets that fits in the given size.
+	TranspositionTable(size_t sizeMegabytes);
+	~TranspositionTable();
+
+	// Looks up the given key, returns true and fills outResult if it's in the table.
+	bool Probe(ZobristKey key, ProbeResult& outResult) const;
+
+	// Stores a search result. bestMove may be none if there wasn't one.
+	void Store(ZobristKey key, int32_t score, int32_t depth, Bound bound, PackedMove bestMove);
+
+	// Starts a new search. Entries from older searches are replaced before current ones.
+	void AdvanceGeneration() { m_generation = (m_generation + 1) & s_generationMask; }
+
+	// Forgets everything.
+	void Clear();
+
+	// Returns how many bytes the table takes up.
+	size_t GetSizeBytes() const { return m_bucketCount * sizeof(Bucket); }
+
+private:
+
+	struct Entry
+	{
+		std::atomic<uint64_t> keyXorData;
+		std::atomic<uint64_t> data;
+	};
+
+	// Entries are grouped so one lookup touches a single cache line.
+	static constexpr size_t s_entriesPerBucket = 4;
+	struct alignas(64) Bucket
+	{
+		std::array<Entry, s_entriesPerBucket> entries;
+	};
+
+	static constexpr uint32_t s_generationMask = 0xF;
+
+	// All buckets, m_bucketCount of them.
+	std::unique_ptr<Bucket[]> m_buckets;
+
+	// Always a power of two, so keys map to buckets with a mask.
+	size_t m_bucketCount = 0;
+
+	// Bumped once per search so stale entries can be told apart.
+	uint32_t m_generation = 0;
+};
+
+//===============================================================
+
+}
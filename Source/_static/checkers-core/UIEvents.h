@@ -12,6 +12,7 @@ namespace Checkers {
 //===============================================================
 
 class IGameBoardViewStrategy;
+struct PerftResult;
 
 // These events are intended to be one direction notifications from the game to the display.
 // The intention is that we could completely rip out the display and rewrite it with whatever we want
@@ -68,6 +69,10 @@ public:
 	using WinConditionMetEvent = observable::subject<void(WinConditionReason reason)>;
 	WinConditionMetEvent& GetWinConditionMetEvent() { return m_winConditionMetEvent; }
 
+	// A perft count requested by the player has finished.
+	using PerftCompletedEvent = observable::subject<void(const PerftResult& result)>;
+	PerftCompletedEvent& GetPerftCompletedEvent() { return m_perftCompletedEvent; }
+
 private:
 	WelcomePromptRequestedEvent m_welcomePromptRequestedEvent;
 	HelpPromptRequestedEvent m_helpPromptRequestedEvent;
@@ -81,6 +86,7 @@ private:
 	WinConditionMetEvent m_winConditionMetEvent;
 	AdditionalPieceCaptureRequiredEvent m_additionalPieceCaptureRequiredEvent;
 	DisplayHintsRequestedEvent m_displayHintsRequestedEvent;
+	PerftCompletedEvent m_perftCompletedEvent;
 };
 
 //===============================================================
@@ -10,7 +10,6 @@
 
 #include <cstdint>
 #include <numeric>
-#include <span>
 
 #include <spdlog/spdlog.h>
 // Magic include needed for spdlog to log a custom type.
@@ -43,20 +42,46 @@ inline glm::ivec2 ToGameBoardCoordFromIndex(int32_t index)
 	return { index / GameplaySettings::s_boardSize, index % GameplaySettings::s_boardSize };
 }
 
-inline bool IsValidGameBoardCoord(const glm::ivec2& coord)
+// Returns whether this square is one of the playable (dark) squares.
+inline bool IsValidSquare(int32_t square)
 {
-	return coord.x >= 0 && coord.x < GameplaySettings::s_boardSize &&
-		coord.y >= 0 && coord.y < GameplaySettings::s_boardSize;
+	return square >= 0 && square < GameplaySettings::s_playableSquareCount;
+}
+
+// Given a flat array index to our game board, returns its playable square, or s_invalidSquare for light squares.
+inline int32_t ToSquareFromGameBoardIndex(int32_t index)
+{
+	if (!IsValidGameBoardIndex(index))
+	{
+		return GameBoardStatics::s_invalidSquare;
+	}
+
+	const int32_t row = index / GameplaySettings::s_boardSize;
+	const int32_t col = index % GameplaySettings::s_boardSize;
+
+	// Dark squares are the ones where row + col is odd.
+	if ((row + col) % 2 == 0)
+	{
+		return GameBoardStatics::s_invalidSquare;
+	}
+
+	return row * (GameplaySettings::s_boardSize / 2) + col / 2;
 }
 
-inline glm::ivec2 GetMoveDestCoord(const glm::ivec2& source, const glm::ivec2& direction)
+// Given a playable square, returns its flat array index to our game board.
+inline int32_t ToGameBoardIndexFromSquare(int32_t square)
 {
-	return source + GameplaySettings::s_moveDistance * direction;
+	const int32_t row = square / (GameplaySettings::s_boardSize / 2);
+
+	// Even rows start on a light square, so their dark squares are shifted one column over.
+	const int32_t col = 2 * (square % (GameplaySettings::s_boardSize / 2)) + (row % 2 == 0 ? 1 : 0);
+	return row * GameplaySettings::s_boardSize + col;
 }
 
-inline glm::ivec2 GetCaptureDestCoord(const glm::ivec2& source, const glm::ivec2& direction)
+inline bool IsValidGameBoardCoord(const glm::ivec2& coord)
 {
-	return source + GameplaySettings::s_captureDistance * direction;
+	return coord.x >= 0 && coord.x < GameplaySettings::s_boardSize &&
+		coord.y >= 0 && coord.y < GameplaySettings::s_boardSize;
 }
 
 // Returns the diagonal distance between a source and a dest. A capture should be 2, a move should be 1.
@@ -71,43 +96,6 @@ inline int32_t GetDistanceFromSourceIndex(int32_t sourceIndex, int32_t destIndex
 	return std::max(rowDiff, colDiff);
 }
 
-inline glm::ivec2 NormalizeDirection(const glm::ivec2& direction)
-{
-	return { direction.x / abs(direction.x), direction.y / abs(direction.y) };
-}
-
-inline glm::ivec2 GetDirectionBetweenTwoIndices(int32_t sourceIndex, int32_t destIndex)
-{
-	const glm::ivec2 sourceCoord = Utility::ToGameBoardCoordFromIndex(sourceIndex);
-	const glm::ivec2 destCoord = Utility::ToGameBoardCoordFromIndex(destIndex);
-	const glm::ivec2 direction = destCoord - sourceCoord;
-
-	return NormalizeDirection(direction);
-}
-
-inline std::span<const glm::ivec2> GetDirectionsForPiece(const Piece& piece)
-{
-	if (piece == GameBoardStatics::s_redPawn)
-	{
-		return GameplaySettings::s_redPawnDirections;
-	}
-	if (piece == GameBoardStatics::s_blackPawn)
-	{
-		return GameplaySettings::s_blackPawnDirections;
-	}
-	if (piece == GameBoardStatics::s_blackKing || piece == GameBoardStatics::s_redKing)
-	{
-		return GameplaySettings::s_kingDirections;
-	}
-#ifdef DEBUG
-	spdlog::error("Attempted to get directions for an unknown piece. piece={}", piece);
-	// I want to know if we get here, it means something is wrong with our equality check.
-	assert(false);
-#endif
-
-	return {};
-}
-
 inline std::string DirectionToString(const glm::ivec2& direction)
 {
 	if (direction == GameBoardStatics::s_up)
@@ -0,0 +1,280 @@
+//---------------------------------------------------------------
+//
+// VariantMoveGenerator.cpp
+//
+
+#include "VariantMoveGenerator.h"
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <span>
+
+namespace Checkers {
+
+//===============================================================
+
+template <typename Rules>
+typename VariantMoveGenerator<Rules>::Board VariantMoveGenerator<Rules>::GetStartingBoard()
+{
+	static constexpr auto s_startingGameBoard = Geometry::BuildStartingGameBoard(Rules::s_pawnRowCount);
+	return Board::FromGameBoard(s_startingGameBoard);
+}
+
+template <typename Rules>
+void VariantMoveGenerator<Rules>::GenerateMoves(const Board& board, Identity playerId, std::vector<Move>& outMoves)
+{
+	const size_t firstMoveIndex = outMoves.size();
+	const SquareMask pieces = board.GetPiecesForId(playerId);
+
+	CaptureChainContext context;
+	context.enemy = board.GetOpponentPiecesForId(playerId);
+	context.kingRow = Board::GetKingRowMask(playerId);
+	context.pawnCaptureDirections = Rules::s_canPawnsCaptureBackward ?
+		typename Tables::DirectionRange{ 0, BitBoard::s_directionCount } :
+		Tables::GetDirectionRange({ PieceType::Pawn, playerId });
+
+	for (SquareMask capturers = pieces; capturers; capturers &= capturers - 1)
+	{
+		const int32_t sourceSquare = std::countr_zero(capturers);
+		const SquareMask sourceMask = Geometry::GetSquareMask(sourceSquare);
+		context.occupied = board.GetOccupied() & ~sourceMask;
+		context.isSourceKing = (board.kings & sourceMask) != 0;
+		context.firstPieceMoveIndex = outMoves.size();
+
+		Move move;
+		move.sourceSquare = static_cast<int8_t>(sourceSquare);
+		ExtendCaptureChain(context, sourceSquare, context.isSourceKing, move, outMoves);
+	}
+
+	if (outMoves.size() > firstMoveIndex)
+	{
+		if constexpr (Rules::s_mustCaptureMost)
+		{
+			const auto captures = std::span(outMoves).subspan(firstMoveIndex);
+			const int8_t mostCaptures = std::ranges::max_element(captures, {}, &Move::captureCount)->captureCount;
+			const auto removedMoves = std::ranges::remove_if(captures,
+				[mostCaptures](const Move& move) { return move.captureCount < mostCaptures; });
+			outMoves.erase(outMoves.end() - removedMoves.size(), outMoves.end());
+		}
+		return;
+	}
+
+	for (SquareMask movers = pieces; movers; movers &= movers - 1)
+	{
+		AddSimpleMoves(board, std::countr_zero(movers), outMoves);
+	}
+}
+
+template <typename Rules>
+void VariantMoveGenerator<Rules>::MakeMove(Board& board, Identity playerId, const Move& move)
+{
+	const SquareMask sourceMask = Geometry::GetSquareMask(move.sourceSquare);
+	const SquareMask destMask = Geometry::GetSquareMask(move.destSquare);
+	const bool isKing = (board.kings & sourceMask) || move.isPromotion;
+
+	SquareMask& ownPieces = playerId == Identity::Red ? board.red : board.black;
+	SquareMask& opponentPieces = playerId == Identity::Red ? board.black : board.red;
+
+	// A king's chain can end where it started, so the source is cleared before the dest is set.
+	ownPieces = (ownPieces & ~sourceMask) | destMask;
+	opponentPieces &= ~move.capturedSquares;
+	board.kings &= ~(sourceMask | move.capturedSquares);
+	if (isKing)
+	{
+		board.kings |= destMask;
+	}
+}
+
+template <typename Rules>
+uint64_t VariantMoveGenerator<Rules>::CountLeaves(const Board& board, Identity playerId, int32_t depth)
+{
+	std::vector<std::vector<Move>> moveBuffers(std::max(depth, 1));
+	return CountLeaves(board, playerId, depth, moveBuffers);
+}
+
+template <typename Rules>
+template <typename JumpVisitor>
+void VariantMoveGenerator<Rules>::ForEachJump(const CaptureChainContext& context, int32_t fromSquare, bool isKing,
+	SquareMask capturedSquares, JumpVisitor&& visitJump)
+{
+	const SquareMask jumpableSquares = context.enemy & ~capturedSquares;
+	const typename Tables::DirectionRange directions = isKing ?
+		typename Tables::DirectionRange{ 0, BitBoard::s_directionCount } : context.pawnCaptureDirections;
+	for (int32_t direction = directions.first; direction < directions.last; ++direction)
+	{
+		if (Rules::s_areKingsFlying && isKing)
+		{
+			// Slide up to the first piece on the diagonal. It has to be one we can take, and then any empty square
+			// past it, up to the next piece, is somewhere to land.
+			const typename Tables::RaySquares& ray = Tables::s_raySquares[fromSquare][direction];
+			size_t distance = 0;
+			while (ray[distance] != GameBoardStatics::s_invalidSquare &&
+				!(context.occupied & Geometry::GetSquareMask(ray[distance])))
+			{
+				++distance;
+			}
+			if (ray[distance] == GameBoardStatics::s_invalidSquare ||
+				!(jumpableSquares & Geometry::GetSquareMask(ray[distance])))
+			{
+				continue;
+			}
+
+			const int32_t capturedSquare = ray[distance++];
+			const size_t firstLandingDistance = distance;
+			while (ray[distance] != GameBoardStatics::s_invalidSquare &&
+				!(context.occupied & Geometry::GetSquareMask(ray[distance])))
+			{
+				++distance;
+			}
+			if (distance > firstLandingDistance)
+			{
+				visitJump(capturedSquare, std::span(ray).subspan(firstLandingDistance, distance - firstLandingDistance));
+			}
+			continue;
+		}
+
+		const SquareMask landingMask = Tables::s_jumpMasks[fromSquare][direction];
+		if (!(Tables::s_stepMasks[fromSquare][direction] & jumpableSquares) || !landingMask ||
+			(landingMask & context.occupied))
+		{
+			continue;
+		}
+		visitJump(Tables::s_stepSquares[fromSquare][direction],
+			std::span(Tables::s_jumpSquares[fromSquare]).subspan(direction, 1));
+	}
+}
+
+template <typename Rules>
+void VariantMoveGenerator<Rules>::ExtendCaptureChain(const CaptureChainContext& context, int32_t fromSquare,
+	bool isKing, Move& move, std::vector<Move>& outMoves)
+{
+	bool isChainExtended = false;
+	ForEachJump(context, fromSquare, isKing, move.capturedSquares,
+		[&](int32_t capturedSquare, std::span<const int8_t> landingSquares)
+	{
+		isChainExtended = true;
+		const SquareMask capturedMask = Geometry::GetSquareMask(capturedSquare);
+		move.capturedSquares |= capturedMask;
+
+		// A flying king can't stop early: if it can land somewhere it keeps capturing from, it has to land there.
+		auto canContinueFrom = [&](int32_t landingSquare)
+		{
+			bool canContinue = false;
+			ForEachJump(context, landingSquare, isKing, move.capturedSquares,
+				[&canContinue](int32_t, std::span<const int8_t>) { canContinue = true; });
+			return canContinue;
+		};
+		const bool mustContinue = landingSquares.size() > 1 && std::ranges::any_of(landingSquares, canContinueFrom);
+
+		for (const int8_t landingSquare : landingSquares)
+		{
+			if (mustContinue && !canContinueFrom(landingSquare))
+			{
+				continue;
+			}
+
+			const bool isCrowned = Rules::s_isPromotedMidCapture &&
+				(context.kingRow & Geometry::GetSquareMask(landingSquare));
+			move.jumpPath[move.captureCount++] = landingSquare;
+			ExtendCaptureChain(context, landingSquare, isKing || isCrowned, move, outMoves);
+			--move.captureCount;
+		}
+
+		move.capturedSquares &= ~capturedMask;
+	});
+
+	// Nothing left to jump, the chain ends here.
+	if (isChainExtended || move.captureCount == 0)
+	{
+		return;
+	}
+
+	move.destSquare = static_cast<int8_t>(fromSquare);
+	move.isPromotion = !context.isSourceKing && (isKing || (context.kingRow & Geometry::GetSquareMask(fromSquare)));
+
+	// The same pieces can often be taken in a different order, those are one move.
+	const auto pieceMoves = std::span(outMoves).subspan(context.firstPieceMoveIndex);
+	if (std::ranges::find(pieceMoves, move) == pieceMoves.end())
+	{
+		outMoves.push_back(move);
+	}
+}
+
+template <typename Rules>
+void VariantMoveGenerator<Rules>::AddSimpleMoves(const Board& board, int32_t sourceSquare, std::vector<Move>& outMoves)
+{
+	const Piece piece = board.GetPieceAtSquare(sourceSquare);
+	const SquareMask empty = board.GetEmpty();
+	const SquareMask kingRow = Board::GetKingRowMask(piece.identity);
+	const bool isKing = piece.pieceType == PieceType::King;
+
+	auto addMove = [&](int32_t destSquare)
+	{
+		Move& move = outMoves.emplace_back();
+		move.sourceSquare = static_cast<int8_t>(sourceSquare);
+		move.destSquare = static_cast<int8_t>(destSquare);
+		move.isPromotion = !isKing && (kingRow & Geometry::GetSquareMask(destSquare));
+	};
+
+	const typename Tables::DirectionRange directions = Tables::GetDirectionRange(piece);
+	for (int32_t direction = directions.first; direction < directions.last; ++direction)
+	{
+		if (Rules::s_areKingsFlying && isKing)
+		{
+			for (const int8_t raySquare : Tables::s_raySquares[sourceSquare][direction])
+			{
+				if (raySquare == GameBoardStatics::s_invalidSquare || !(empty & Geometry::GetSquareMask(raySquare)))
+				{
+					break;
+				}
+				addMove(raySquare);
+			}
+			continue;
+		}
+
+		if (Tables::s_stepMasks[sourceSquare][direction] & empty)
+		{
+			addMove(Tables::s_stepSquares[sourceSquare][direction]);
+		}
+	}
+}
+
+template <typename Rules>
+uint64_t VariantMoveGenerator<Rules>::CountLeaves(const Board& board, Identity playerId, int32_t depth,
+	std::vector<std::vector<Move>>& moveBuffers)
+{
+	if (depth == 0)
+	{
+		return 1;
+	}
+
+	std::vector<Move>& moves = moveBuffers[depth - 1];
+	moves.clear();
+	GenerateMoves(board, playerId, moves);
+
+	// Every move at the last ply is a leaf, no need to play them out.
+	if (depth == 1)
+	{
+		return moves.size();
+	}
+
+	const Identity opponentId = playerId == Identity::Red ? Identity::Black : Identity::Red;
+	uint64_t leaves = 0;
+	for (const Move& move : moves)
+	{
+		Board childBoard = board;
+		MakeMove(childBoard, playerId, move);
+		leaves += CountLeaves(childBoard, opponentId, depth - 1, moveBuffers);
+	}
+	return leaves;
+}
+
+template class VariantMoveGenerator<AmericanRules>;
+template class VariantMoveGenerator<InternationalRules>;
+template class VariantMoveGenerator<RussianRules>;
+template class VariantMoveGenerator<BrazilianRules>;
+
+//===============================================================
+
+}
@@ -0,0 +1,135 @@
+//---------------------------------------------------------------
+//
+// VariantMoveGenerator.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameTypes.h"
+#include "RuleSets.h"
+#include "SquareTables.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+// A whole turn in any variant: either a simple move, or a complete capture chain. GameMove is the 8x8 American one
+// the game itself uses, this is the same thing sized for whatever board and piece count the rules have.
+template <typename Rules>
+struct VariantMove
+{
+	using SquareMask = typename Rules::Geometry::SquareMask;
+
+	// Playable square the moving piece starts the turn on.
+	int8_t sourceSquare = GameBoardStatics::s_invalidSquare;
+
+	// Playable square the moving piece ends the turn on.
+	int8_t destSquare = GameBoardStatics::s_invalidSquare;
+
+	// Number of jumps in this turn, 0 for a simple move.
+	int8_t captureCount = 0;
+
+	// True if the moving pawn is crowned by this turn.
+	bool isPromotion = false;
+
+	// Every square that was jumped over this turn.
+	SquareMask capturedSquares = 0;
+
+	// Landing square of each jump, in order. Only the first captureCount entries are meaningful.
+	std::array<int8_t, Rules::s_pieceCount> jumpPath{};
+
+	constexpr bool IsCapture() const { return captureCount > 0; }
+
+	// Chains that start and end on the same squares and take the same pieces are the same move, whatever the order.
+	bool operator==(const VariantMove& other) const
+	{
+		return sourceSquare == other.sourceSquare && destSquare == other.destSquare &&
+			capturedSquares == other.capturedSquares;
+	}
+};
+
+// Generates and plays whole turns for a variant, for anything that needs to look at the other variants' trees
+// (perft, tooling, an engine for them). The rules are template constants, so each variant compiles to its own
+// generator with none of the others' checks in it. The game itself runs on MoveDiscoveryEngine, a separate generator
+// tuned for the console game. For American rules the two generate the same turns, checkers-selfcheck holds them to it.
+template <typename Rules>
+class VariantMoveGenerator
+{
+public:
+	using Geometry = typename Rules::Geometry;
+	using Board = BasicBitBoard<Geometry>;
+	using SquareMask = typename Geometry::SquareMask;
+	using Move = VariantMove<Rules>;
+
+	// Returns the variant's starting position. Red moves first.
+	static Board GetStartingBoard();
+
+	// Appends every legal turn for the player to outMoves. Captures are mandatory, and under majority capture only
+	// the ones taking the most pieces are legal.
+	static void GenerateMoves(const Board& board, Identity playerId, std::vector<Move>& outMoves);
+
+	// Plays a turn generated for the player on the board.
+	static void MakeMove(Board& board, Identity playerId, const Move& move);
+
+	// Counts every position exactly depth turns below this one (perft). Turns alternate starting with playerId.
+	static uint64_t CountLeaves(const Board& board, Identity playerId, int32_t depth);
+
+private:
+	using Tables = BasicSquareTables<Geometry>;
+
+	// Everything a capture chain search carries along. The board isn't changed as the chain goes: captured pieces
+	// stay where they are until the turn ends.
+	struct CaptureChainContext
+	{
+		// Every piece on the board, less the one that's capturing (it's been lifted off its square).
+		SquareMask occupied = 0;
+
+		// The opponent's pieces.
+		SquareMask enemy = 0;
+
+		// The capturing player's king row.
+		SquareMask kingRow = 0;
+
+		// Directions a pawn of the capturing player may jump in.
+		typename Tables::DirectionRange pawnCaptureDirections;
+
+		// True if the capturing piece started the turn as a king.
+		bool isSourceKing = false;
+
+		// Where this piece's chains start in the output, so repeats are only checked against its own.
+		size_t firstPieceMoveIndex = 0;
+	};
+
+	// Calls visitJump(capturedSquare, landingSquares) for every piece the piece on fromSquare could jump next. A
+	// flying king can land on any of several squares past the piece, the rest only ever have the one.
+	template <typename JumpVisitor>
+	static void ForEachJump(const CaptureChainContext& context, int32_t fromSquare, bool isKing,
+		SquareMask capturedSquares, JumpVisitor&& visitJump);
+
+	// Extends the chain in move from fromSquare, recursing for every jump available, and adds it to outMoves once
+	// it can't go any further.
+	static void ExtendCaptureChain(const CaptureChainContext& context, int32_t fromSquare, bool isKing, Move& move,
+		std::vector<Move>& outMoves);
+
+	// Adds the simple moves of the piece on the given square.
+	static void AddSimpleMoves(const Board& board, int32_t sourceSquare, std::vector<Move>& outMoves);
+
+	// Counts leaves below a position, reusing one move list per ply.
+	static uint64_t CountLeaves(const Board& board, Identity playerId, int32_t depth,
+		std::vector<std::vector<Move>>& moveBuffers);
+};
+
+// Every variant we host is compiled once, in VariantMoveGenerator.cpp.
+extern template class VariantMoveGenerator<AmericanRules>;
+extern template class VariantMoveGenerator<InternationalRules>;
+extern template class VariantMoveGenerator<RussianRules>;
+extern template class VariantMoveGenerator<BrazilianRules>;
+
+//===============================================================
+
+}
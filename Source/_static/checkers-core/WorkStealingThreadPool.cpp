@@ -0,0 +1,140 @@
+//---------------------------------------------------------------
+//
+// WorkStealingThreadPool.cpp
+//
+
+#include "WorkStealingThreadPool.h"
+
+#include <algorithm>
+
+namespace Checkers {
+
+//===============================================================
+
+WorkStealingThreadPool::WorkStealingThreadPool(int32_t threadCount)
+{
+	threadCount = std::max(threadCount, 1);
+
+	m_queues.reserve(threadCount);
+	for (int32_t workerIndex = 0; workerIndex < threadCount; ++workerIndex)
+	{
+		m_queues.push_back(std::make_unique<WorkerQueue>());
+	}
+
+	// Every queue has to exist before any worker starts looking for something to steal.
+	m_workers.reserve(threadCount);
+	for (int32_t workerIndex = 0; workerIndex < threadCount; ++workerIndex)
+	{
+		m_workers.emplace_back(&WorkStealingThreadPool::WorkerLoop, this, workerIndex);
+	}
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+	{
+		std::scoped_lock lock(m_batchMutex);
+		m_isShuttingDown = true;
+	}
+	m_batchStartedCondition.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+void WorkStealingThreadPool::RunBatch(std::vector<Task> tasks)
+{
+	if (tasks.empty())
+	{
+		return;
+	}
+
+	std::unique_lock lock(m_batchMutex);
+	m_remainingTaskCount.store(tasks.size(), std::memory_order_relaxed);
+
+	// Nobody is running yet, so the queues can be filled without fighting anyone for them.
+	for (size_t taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+	{
+		WorkerQueue& queue = *m_queues[taskIndex % m_queues.size()];
+		std::scoped_lock queueLock(queue.mutex);
+		queue.tasks.push_back(std::move(tasks[taskIndex]));
+	}
+
+	++m_batchId;
+	m_batchStartedCondition.notify_all();
+	m_batchFinishedCondition.wait(lock, [this]()
+	{
+		return m_remainingTaskCount.load(std::memory_order_acquire) == 0;
+	});
+}
+
+void WorkStealingThreadPool::WorkerLoop(int32_t workerIndex)
+{
+	uint64_t lastBatchId = 0;
+	while (true)
+	{
+		{
+			std::unique_lock lock(m_batchMutex);
+			m_batchStartedCondition.wait(lock, [this, lastBatchId]()
+			{
+				return m_isShuttingDown || m_batchId != lastBatchId;
+			});
+
+			if (m_isShuttingDown)
+			{
+				return;
+			}
+			lastBatchId = m_batchId;
+		}
+
+		// Every task of the batch was queued before it started, so once nothing is left to take, we're done with it.
+		Task task;
+		while (TryTakeTask(workerIndex, task))
+		{
+			task(workerIndex);
+			task = nullptr;
+
+			if (m_remainingTaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				// Take the lock so the wakeup can't slip in between RunBatch checking the count and going to sleep.
+				std::scoped_lock lock(m_batchMutex);
+				m_batchFinishedCondition.notify_all();
+			}
+		}
+	}
+}
+
+bool WorkStealingThreadPool::TryTakeTask(int32_t workerIndex, Task& outTask)
+{
+	{
+		WorkerQueue& ownQueue = *m_queues[workerIndex];
+		std::scoped_lock lock(ownQueue.mutex);
+		if (!ownQueue.tasks.empty())
+		{
+			outTask = std::move(ownQueue.tasks.back());
+			ownQueue.tasks.pop_back();
+			return true;
+		}
+	}
+
+	// Steal the oldest task from the next worker over that has any. The oldest tasks are usually the biggest ones.
+	const size_t queueCount = m_queues.size();
+	for (size_t offset = 1; offset < queueCount; ++offset)
+	{
+		WorkerQueue& victimQueue = *m_queues[(workerIndex + offset) % queueCount];
+		std::scoped_lock lock(victimQueue.mutex);
+		if (!victimQueue.tasks.empty())
+		{
+			outTask = std::move(victimQueue.tasks.front());
+			victimQueue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//===============================================================
+
+}
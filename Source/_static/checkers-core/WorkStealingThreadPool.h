@@ -0,0 +1,83 @@
+//---------------------------------------------------------------
+//
+// WorkStealingThreadPool.h
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+// A fixed set of worker threads that run batches of tasks. Every worker has its own queue. Tasks are dealt out to
+// the queues round-robin, each worker takes from the back of its own queue, and a worker whose queue runs dry steals
+// from the front of the others'. Subtrees in checkers vary wildly in size, so this keeps every worker busy until
+// the batch is done without anyone having to guess the sizes up front.
+class WorkStealingThreadPool
+{
+public:
+
+	// A task is told which worker is running it, so it can use per-worker scratch data without locking.
+	using Task = std::function<void(int32_t workerIndex)>;
+
+	WorkStealingThreadPool(const WorkStealingThreadPool& other) = delete;
+	WorkStealingThreadPool& operator=(const WorkStealingThreadPool& other) = delete;
+	WorkStealingThreadPool(WorkStealingThreadPool&& other) noexcept = delete;
+	WorkStealingThreadPool& operator=(WorkStealingThreadPool&& other) noexcept = delete;
+
+	// Starts the given number of workers (at least one). They sleep until a batch is handed to them.
+	WorkStealingThreadPool(int32_t threadCount);
+	~WorkStealingThreadPool();
+
+	// Runs every task in the batch and returns once they have all finished. Only one batch runs at a time.
+	void RunBatch(std::vector<Task> tasks);
+
+	int32_t GetThreadCount() const { return static_cast<int32_t>(m_workers.size()); }
+
+private:
+
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	// Runs batches until the pool shuts down.
+	void WorkerLoop(int32_t workerIndex);
+
+	// Takes a task from the worker's own queue, or failing that, steals one from another worker.
+	bool TryTakeTask(int32_t workerIndex, Task& outTask);
+
+	// One queue per worker, indexed the same as m_workers.
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+
+	std::vector<std::thread> m_workers;
+
+	// Guards the batch bookkeeping below, and is what the condition variables wait on.
+	std::mutex m_batchMutex;
+	std::condition_variable m_batchStartedCondition;
+	std::condition_variable m_batchFinishedCondition;
+
+	// Bumped every time a batch is handed out, so sleeping workers can tell a new batch from a spurious wakeup.
+	uint64_t m_batchId = 0;
+
+	// Tasks in the current batch that haven't finished yet.
+	std::atomic<size_t> m_remainingTaskCount = 0;
+
+	// Raised when the pool is being destroyed.
+	bool m_isShuttingDown = false;
+};
+
+//===============================================================
+
+}
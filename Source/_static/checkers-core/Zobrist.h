@@ -0,0 +1,102 @@
+//---------------------------------------------------------------
+//
+// Zobrist.h
+//
+
+#pragma once
+
+#include "BitBoard.h"
+#include "GameSettings.h"
+#include "GameTypes.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+// A Zobrist key identifies a position (board + side to move) in 64 bits. Every (piece, square) pair gets a random
+// key and a position's key is the XOR of the keys of everything on it, so a move only needs to XOR out what left
+// and XOR in what arrived. This is the key shared by repetition detection and anything that caches positions.
+using ZobristKey = uint64_t;
+
+namespace Zobrist {
+
+// Red pawn, red king, black pawn, black king.
+inline constexpr int32_t s_pieceKindCount = 4;
+
+// The seed is fixed so that keys are stable across runs and processes, and can be stored on disk.
+inline constexpr uint64_t s_seed = 0x436865636B657273ull;
+
+// SplitMix64, which is small enough to run at compile time and has well distributed output for key tables.
+constexpr uint64_t SplitMix64(uint64_t& state)
+{
+	uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+using PieceKeyTable = std::array<std::array<ZobristKey, GameplaySettings::s_playableSquareCount>, s_pieceKindCount>;
+
+struct KeyTables
+{
+	PieceKeyTable pieceKeys{};
+	ZobristKey blackToMoveKey = 0;
+};
+
+constexpr KeyTables GenerateKeyTables()
+{
+	KeyTables tables;
+	uint64_t state = s_seed;
+	for (auto& squareKeys : tables.pieceKeys)
+	{
+		for (ZobristKey& key : squareKeys)
+		{
+			key = SplitMix64(state);
+		}
+	}
+
+	// Continue the same stream so the side key can't repeat a piece key.
+	tables.blackToMoveKey = SplitMix64(state);
+	return tables;
+}
+
+inline constexpr KeyTables s_keyTables = GenerateKeyTables();
+
+// Returns the key for the given piece sitting on the given playable square. Empty squares have no key.
+constexpr ZobristKey GetPieceKey(const Piece& piece, int32_t square)
+{
+	if (piece.identity == Identity::Neutral)
+	{
+		return 0;
+	}
+
+	const int32_t pieceKindIndex = (piece.identity == Identity::Red ? 0 : 2) + (piece.pieceType == PieceType::King ? 1 : 0);
+	return s_keyTables.pieceKeys[pieceKindIndex][square];
+}
+
+// Mixed into the key whenever it's black's turn. Red (and the pre-game neutral turn) mixes in nothing.
+constexpr ZobristKey GetBlackToMoveKey()
+{
+	return s_keyTables.blackToMoveKey;
+}
+
+// Computes a key from scratch. Game code keeps its key up to date incrementally, this is for seeding that key and
+// for verifying it.
+inline ZobristKey GenerateKey(const BitBoard& board, Identity turnPlayer)
+{
+	ZobristKey key = turnPlayer == Identity::Black ? GetBlackToMoveKey() : 0;
+	for (int32_t square = 0; square < GameplaySettings::s_playableSquareCount; ++square)
+	{
+		key ^= GetPieceKey(board.GetPieceAtSquare(square), square);
+	}
+	return key;
+}
+
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,96 @@
+#include "checkers-core/CommandLine.h"
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/OpeningBookBuilder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+static constexpr std::string_view s_usageText =
+	"Usage: checkers-book --corpus FILE [options]\n"
+	"  --corpus FILE         Games to build the book from, one per line: moves in checkers notation, then the\n"
+	"                        result (1-0 red won, 0-1 black won, 1/2-1/2 drawn).\n"
+	"  --plies N             Turns from the start of each game that go into the book.\n"
+	"  --min-games N         Leave out moves fewer games than this played.\n"
+	"  --threads N           Threads the games are replayed on. Defaults to every core.\n"
+	"  --output FILE         Where the book is written.\n";
+
+// Everything the builder was asked to do.
+struct BookConfig
+{
+	std::filesystem::path corpusPath;
+	std::filesystem::path outputPath = Checkers::OpeningBookSettings::s_defaultPath;
+	Checkers::OpeningBookBuilder::BuildOptions options;
+	int32_t threadCount = 1;
+};
+
+static bool ParseArguments(std::span<char*> arguments, BookConfig& outConfig)
+{
+	const bool isValid = Checkers::CommandLine::ParseOptions(arguments,
+		[&outConfig](std::string_view option, std::string_view value)
+	{
+		if (option == "--corpus")
+		{
+			outConfig.corpusPath = value;
+			return true;
+		}
+		if (option == "--plies")
+		{
+			return Checkers::CommandLine::ParsePositiveInt(value, outConfig.options.maxPly);
+		}
+		if (option == "--min-games")
+		{
+			return Checkers::CommandLine::ParsePositiveInt(value, outConfig.options.minGameCount);
+		}
+		if (option == "--threads")
+		{
+			return Checkers::CommandLine::ParsePositiveInt(value, outConfig.threadCount);
+		}
+		if (option == "--output")
+		{
+			outConfig.outputPath = value;
+			return true;
+		}
+		return false;
+	});
+
+	// There's no book without games.
+	return isValid && !outConfig.corpusPath.empty();
+}
+
+int main(int argc, char* argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	BookConfig config;
+	config.threadCount = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+	if (!ParseArguments(std::span<char*>(argv + 1, argc - 1), config))
+	{
+		std::cerr << s_usageText;
+		return 1;
+	}
+
+	Checkers::OpeningBookBuilder builder(config.threadCount);
+	Checkers::OpeningBookBuilder::BuildStats stats;
+	if (!builder.Build(config.corpusPath, config.options, stats))
+	{
+		std::cerr << "Couldn't read " << config.corpusPath.string() << ".\n";
+		return 1;
+	}
+
+	if (!builder.Write(config.outputPath))
+	{
+		std::cerr << "Couldn't write " << config.outputPath.string() << ".\n";
+		return 1;
+	}
+
+	std::cout << stats.gameCount << " games (" << stats.skippedGameCount << " skipped), " << stats.positionCount
+		<< " positions, " << stats.entryCount << " moves, " << stats.elapsed.count() << " ms\n";
+	return 0;
+}
@@ -0,0 +1,377 @@
+#include "checkers-core/BitBoard.h"
+#include "checkers-core/CommandLine.h"
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/GameState.h"
+#include "checkers-core/GameTypes.h"
+#include "checkers-core/MoveDiscoveryEngine.h"
+#include "checkers-core/SearchEngine.h"
+#include "checkers-core/Utility.h"
+#include "checkers-core/VariantMoveGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+
+static constexpr std::string_view s_usageText =
+	"Usage: checkers-selfcheck [options]\n"
+	"  --games N             Random games to play through every check.\n"
+	"  --seed N              Seed for the random games, so a failure can be played again.\n";
+
+// Longest a random game is allowed to go. Random play rarely finishes a game on its own, and kings shuffling around
+// the board late in a game are exactly what the checks want to see.
+static constexpr int32_t s_maxTurnsPerGame = 300;
+
+// Everything the checks were asked to do.
+struct SelfCheckConfig
+{
+	int32_t gameCount = 1000;
+	uint32_t seed = 1;
+};
+
+static bool ParseArguments(std::span<char*> arguments, SelfCheckConfig& outConfig)
+{
+	return Checkers::CommandLine::ParseOptions(arguments, [&outConfig](std::string_view option, std::string_view value)
+	{
+		if (option == "--games")
+		{
+			return Checkers::CommandLine::ParsePositiveInt(value, outConfig.gameCount);
+		}
+		if (option == "--seed")
+		{
+			int32_t seed = 0;
+			const bool isValid = Checkers::CommandLine::ParsePositiveInt(value, seed);
+			outConfig.seed = static_cast<uint32_t>(seed);
+			return isValid;
+		}
+		return false;
+	});
+}
+
+// A king capture chain that passes back through its own starting square: red's king on 1 can go 1x10x3x12x19x10,
+// and stopping at 19 would leave a capture untaken.
+static constexpr Checkers::BitBoard s_kingLoopPosition =
+	{ .red = 0x8c021001, .black = 0x0000c0e0, .kings = 0x00000001 };
+
+// Odds, out of 8, that a square of a random position holds a piece of either color.
+static constexpr uint32_t s_randomPieceOdds = 3;
+
+// Plays a turn twice: once whole with ApplyMove, the way search, perft and the tournament do, and once a step at a
+// time with MovePiece, the way a player (or Game::PlayComputerTurn) does. Returns whether both end in the same place.
+static bool PlayTurnBothWays(Checkers::GameState& wholeTurnState, Checkers::GameState& stepByStepState,
+	const Checkers::GameMove& move)
+{
+	wholeTurnState.ApplyMove(move);
+
+	int32_t stepSourceSquare = move.sourceSquare;
+	const int32_t stepCount = move.IsCapture() ? move.captureCount : 1;
+	for (int32_t step = 0; step < stepCount; ++step)
+	{
+		const int32_t stepDestSquare = move.IsCapture() ? move.jumpPath[step] : move.destSquare;
+		stepByStepState.MovePiece({ Checkers::Utility::ToGameBoardIndexFromSquare(stepSourceSquare),
+			Checkers::Utility::ToGameBoardIndexFromSquare(stepDestSquare) });
+		stepSourceSquare = stepDestSquare;
+	}
+
+	const Checkers::BitBoard& wholeTurnBoard = wholeTurnState.GetBoard();
+	const Checkers::BitBoard& stepByStepBoard = stepByStepState.GetBoard();
+	return wholeTurnBoard.red == stepByStepBoard.red && wholeTurnBoard.black == stepByStepBoard.black &&
+		wholeTurnBoard.kings == stepByStepBoard.kings &&
+		wholeTurnState.GetTurnPlayerId() == stepByStepState.GetTurnPlayerId() &&
+		wholeTurnState.GetZobristKey() == stepByStepState.GetZobristKey() &&
+		wholeTurnState.GetWinState() == stepByStepState.GetWinState();
+}
+
+// Plays every turn MoveDiscoveryEngine::GenerateGameMoves offers from the given position both ways. Returns how many
+// didn't end in the same place.
+static uint64_t CheckEveryTurnFrom(const Checkers::BitBoard& board, Checkers::Identity turnPlayerId,
+	uint64_t& outTurnCount)
+{
+	Checkers::GameState wholeTurnState(nullptr);
+	Checkers::GameState stepByStepState(nullptr);
+	wholeTurnState.SetUpPosition(board, turnPlayerId);
+
+	std::vector<Checkers::GameMove> moves;
+	Checkers::MoveDiscoveryEngine::GenerateGameMoves(wholeTurnState, moves);
+
+	uint64_t failureCount = 0;
+	for (const Checkers::GameMove& move : moves)
+	{
+		wholeTurnState.SetUpPosition(board, turnPlayerId);
+		stepByStepState.SetUpPosition(board, turnPlayerId);
+
+		++outTurnCount;
+		if (!PlayTurnBothWays(wholeTurnState, stepByStepState, move))
+		{
+			std::cout << "Turn " << move << " played differently step by step. red=" << std::hex << board.red
+				<< " black=" << board.black << " kings=" << board.kings << std::dec << "\n";
+			++failureCount;
+		}
+	}
+	return failureCount;
+}
+
+// Scatters pieces over the board at random. Pawns that land on the row they'd be promoted on are made kings, since
+// a pawn can never stand there.
+static Checkers::BitBoard MakeRandomBoard(std::mt19937& random)
+{
+	Checkers::BitBoard board;
+	for (int32_t square = 0; square < Checkers::GameplaySettings::Rules::Geometry::s_playableSquareCount; ++square)
+	{
+		const uint32_t roll = random() % 8;
+		if (roll >= s_randomPieceOdds * 2)
+		{
+			continue;
+		}
+
+		const Checkers::BitBoard::SquareMask squareMask = Checkers::BitBoard::GetSquareMask(square);
+		const Checkers::Identity playerId = roll < s_randomPieceOdds ? Checkers::Identity::Red : Checkers::Identity::Black;
+		(playerId == Checkers::Identity::Red ? board.red : board.black) |= squareMask;
+		if (random() % 2 == 0 || (squareMask & Checkers::BitBoard::GetKingRowMask(playerId)) != 0)
+		{
+			board.kings |= squareMask;
+		}
+	}
+	return board;
+}
+
+// Plays random games from the starting position, plus every turn from random positions full of kings that the
+// starting position rarely leads to. Returns how many turns didn't end in the same place played whole and step by
+// step.
+static uint64_t CheckTurnsPlayStepByStep(const SelfCheckConfig& config, uint64_t& outTurnCount)
+{
+	uint64_t failureCount = CheckEveryTurnFrom(s_kingLoopPosition, Checkers::Identity::Red, outTurnCount);
+
+	std::mt19937 random(config.seed);
+	std::vector<Checkers::GameMove> moves;
+	for (int32_t game = 0; game < config.gameCount; ++game)
+	{
+		Checkers::GameState wholeTurnState(nullptr);
+		Checkers::GameState stepByStepState(nullptr);
+		wholeTurnState.ToggleTurnPlayer();
+		stepByStepState.ToggleTurnPlayer();
+
+		for (int32_t turn = 0; turn < s_maxTurnsPerGame; ++turn)
+		{
+			if (wholeTurnState.GetWinState() != Checkers::WinConditionReason::None)
+			{
+				break;
+			}
+
+			moves.clear();
+			Checkers::MoveDiscoveryEngine::GenerateGameMoves(wholeTurnState, moves);
+			if (moves.empty())
+			{
+				break;
+			}
+
+			const Checkers::GameMove& move = moves[random() % moves.size()];
+			++outTurnCount;
+			if (!PlayTurnBothWays(wholeTurnState, stepByStepState, move))
+			{
+				std::cout << "Turn " << move << " played differently step by step. game=" << game << " turn=" << turn
+					<< "\n";
+				++failureCount;
+
+				// The two states have gone their separate ways, nothing more this game can be compared.
+				break;
+			}
+		}
+
+		const Checkers::BitBoard randomBoard = MakeRandomBoard(random);
+		const Checkers::Identity turnPlayerId = game % 2 == 0 ? Checkers::Identity::Red : Checkers::Identity::Black;
+		failureCount += CheckEveryTurnFrom(randomBoard, turnPlayerId, outTurnCount);
+	}
+	return failureCount;
+}
+
+// The game's generator and VariantMoveGenerator have to agree on American rules.
+using AmericanMoveGenerator = Checkers::VariantMoveGenerator<Checkers::AmericanRules>;
+
+// What makes two turns the same turn, whichever generator they came from.
+using TurnKey = std::tuple<int32_t, int32_t, uint32_t>;
+
+// Returns whether MoveDiscoveryEngine and VariantMoveGenerator offer the same turns in the state's position.
+static bool DoGeneratorsAgree(const Checkers::GameState& state)
+{
+	std::vector<Checkers::GameMove> gameMoves;
+	Checkers::MoveDiscoveryEngine::GenerateGameMoves(state, gameMoves);
+	std::vector<AmericanMoveGenerator::Move> variantMoves;
+	AmericanMoveGenerator::GenerateMoves(state.GetBoard(), state.GetTurnPlayerId(), variantMoves);
+
+	std::vector<TurnKey> gameTurns;
+	for (const Checkers::GameMove& move : gameMoves)
+	{
+		gameTurns.emplace_back(move.sourceSquare, move.destSquare, move.capturedSquares);
+	}
+	std::vector<TurnKey> variantTurns;
+	for (const AmericanMoveGenerator::Move& move : variantMoves)
+	{
+		variantTurns.emplace_back(move.sourceSquare, move.destSquare, move.capturedSquares);
+	}
+
+	// Neither generator promises an order, and chains taking the same pieces in another order are the same turn.
+	for (std::vector<TurnKey>* turns : { &gameTurns, &variantTurns })
+	{
+		std::ranges::sort(*turns);
+		turns->erase(std::ranges::unique(*turns).begin(), turns->end());
+	}
+	return gameTurns == variantTurns;
+}
+
+// Compares the two generators over every position of random games from the start, and over random positions full of
+// kings. Returns how many positions they disagreed on.
+static uint64_t CheckGeneratorsAgree(const SelfCheckConfig& config, uint64_t& outPositionCount)
+{
+	uint64_t failureCount = 0;
+	auto checkPosition = [&failureCount, &outPositionCount](const Checkers::GameState& state)
+	{
+		++outPositionCount;
+		if (!DoGeneratorsAgree(state))
+		{
+			const Checkers::BitBoard& board = state.GetBoard();
+			std::cout << "Generators disagree. red=" << std::hex << board.red << " black=" << board.black << " kings="
+				<< board.kings << std::dec << " turn=" << state.GetTurnPlayerId() << "\n";
+			++failureCount;
+		}
+	};
+
+	Checkers::GameState state(nullptr);
+	state.SetUpPosition(s_kingLoopPosition, Checkers::Identity::Red);
+	checkPosition(state);
+
+	std::mt19937 random(config.seed);
+	std::vector<Checkers::GameMove> moves;
+	for (int32_t game = 0; game < config.gameCount; ++game)
+	{
+		state.SetUpPosition(AmericanMoveGenerator::GetStartingBoard(), Checkers::Identity::Red);
+		for (int32_t turn = 0; turn < s_maxTurnsPerGame; ++turn)
+		{
+			checkPosition(state);
+			if (state.GetWinState() != Checkers::WinConditionReason::None)
+			{
+				break;
+			}
+
+			moves.clear();
+			Checkers::MoveDiscoveryEngine::GenerateGameMoves(state, moves);
+			if (moves.empty())
+			{
+				break;
+			}
+			state.ApplyMove(moves[random() % moves.size()]);
+		}
+
+		const Checkers::Identity turnPlayerId = game % 2 == 0 ? Checkers::Identity::Red : Checkers::Identity::Black;
+		state.SetUpPosition(MakeRandomBoard(random), turnPlayerId);
+		checkPosition(state);
+	}
+	return failureCount;
+}
+
+// Three red kings against a lone black king in the corner, each side with a king to shuffle back and forth.
+static constexpr Checkers::BitBoard s_shufflePosition =
+	{ .red = 0xe0000000, .black = 0x00000001, .kings = 0xe0000001 };
+
+// How deep the repetition checks search. Far more than it takes to see a repetition one turn away.
+static constexpr int32_t s_repetitionSearchDepth = 10;
+
+static Checkers::GameMove MakeSimpleMove(int32_t sourceSquare, int32_t destSquare)
+{
+	Checkers::GameMove move;
+	move.sourceSquare = static_cast<int8_t>(sourceSquare);
+	move.destSquare = static_cast<int8_t>(destSquare);
+	return move;
+}
+
+// Shuffles the player to move's king out and back, and the opponent's, until one more shuffle would make the position
+// come up for the game's repetition draw, then searches it. The search only sees the game's history through
+// GameState, none of it is in the undo journal.
+static Checkers::SearchEngine::SearchResult SearchAfterShuffles(Checkers::Identity turnPlayerId,
+	const Checkers::GameMove& turnPlayerMove, const Checkers::GameMove& opponentMove)
+{
+	Checkers::GameState state(nullptr);
+	state.SetUpPosition(s_shufflePosition, turnPlayerId);
+
+	auto makeReturnMove = [](const Checkers::GameMove& move)
+	{
+		return MakeSimpleMove(move.destSquare, move.sourceSquare);
+	};
+	for (int32_t shuffle = 1; shuffle < Checkers::GameplaySettings::s_gameStateRuleCount; ++shuffle)
+	{
+		state.ApplyMove(turnPlayerMove);
+		state.ApplyMove(opponentMove);
+		state.ApplyMove(makeReturnMove(turnPlayerMove));
+		state.ApplyMove(makeReturnMove(opponentMove));
+	}
+
+	Checkers::SearchEngine searchEngine(1, 1);
+	const Checkers::SearchEngine::SearchLimits limits =
+		{ .maxDepth = s_repetitionSearchDepth, .maxTime = std::chrono::minutes(1) };
+	return searchEngine.Search(state, limits);
+}
+
+// The search has to count positions from earlier in the game towards a repetition: the winning side must find another
+// way on than the move that repeats, and the losing side must take the draw it offers. Returns how many didn't.
+static uint64_t CheckSearchSeesGameRepetitions()
+{
+	const Checkers::GameMove redMove = MakeSimpleMove(29, 24);
+	const Checkers::GameMove blackMove = MakeSimpleMove(0, 4);
+	uint64_t failureCount = 0;
+
+	const Checkers::SearchEngine::SearchResult winningResult =
+		SearchAfterShuffles(Checkers::Identity::Red, redMove, blackMove);
+	if (winningResult.bestMove == redMove || winningResult.score <= 0)
+	{
+		std::cout << "Winning side repeated into a draw. move=" << winningResult.bestMove << " score="
+			<< winningResult.score << "\n";
+		++failureCount;
+	}
+
+	const Checkers::SearchEngine::SearchResult losingResult =
+		SearchAfterShuffles(Checkers::Identity::Black, blackMove, redMove);
+	if (!(losingResult.bestMove == blackMove) || losingResult.score != 0)
+	{
+		std::cout << "Losing side missed a repetition draw. move=" << losingResult.bestMove << " score="
+			<< losingResult.score << "\n";
+		++failureCount;
+	}
+	return failureCount;
+}
+
+int main(int argc, char* argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	SelfCheckConfig config;
+	if (!ParseArguments(std::span<char*>(argv + 1, argc - 1), config))
+	{
+		std::cerr << s_usageText;
+		return 1;
+	}
+
+	uint64_t turnCount = 0;
+	const uint64_t turnFailureCount = CheckTurnsPlayStepByStep(config, turnCount);
+	std::cout << "Whole turns vs step by step: " << turnCount << " turns, " << turnFailureCount << " failed\n";
+
+	uint64_t positionCount = 0;
+	const uint64_t generatorFailureCount = CheckGeneratorsAgree(config, positionCount);
+	std::cout << "MoveDiscoveryEngine vs VariantMoveGenerator: " << positionCount << " positions, "
+		<< generatorFailureCount << " failed\n";
+
+	const uint64_t repetitionFailureCount = CheckSearchSeesGameRepetitions();
+	std::cout << "Search vs game repetitions: " << repetitionFailureCount << " failed\n";
+
+	return turnFailureCount == 0 && generatorFailureCount == 0 && repetitionFailureCount == 0 ? 0 : 1;
+}
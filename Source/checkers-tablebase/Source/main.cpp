@@ -0,0 +1,80 @@
+#include "checkers-core/CommandLine.h"
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/TablebaseGenerator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+static constexpr std::string_view s_usageText =
+	"Usage: checkers-tablebase [options]\n"
+	"  --pieces N            Build every database with up to N pieces on the board, at most 8.\n"
+	"  --threads N           Threads each pass runs on. Defaults to every core.\n"
+	"  --output DIR          Directory the databases are written to.\n";
+
+// Everything the generator was asked to do.
+struct TablebaseConfig
+{
+	int32_t maxPieceCount = Checkers::TablebaseSettings::s_maxPieceCount;
+	int32_t threadCount = 1;
+	std::filesystem::path outputDirectory = Checkers::TablebaseSettings::s_defaultDirectory;
+};
+
+static bool ParseArguments(std::span<char*> arguments, TablebaseConfig& outConfig)
+{
+	return Checkers::CommandLine::ParseOptions(arguments, [&outConfig](std::string_view option, std::string_view value)
+	{
+		if (option == "--pieces")
+		{
+			// It takes two pieces to have a game.
+			return Checkers::CommandLine::ParsePositiveInt(value, outConfig.maxPieceCount) &&
+				outConfig.maxPieceCount >= 2 && outConfig.maxPieceCount <= Checkers::TablebaseSettings::s_maxPieceCount;
+		}
+		if (option == "--threads")
+		{
+			return Checkers::CommandLine::ParsePositiveInt(value, outConfig.threadCount);
+		}
+		if (option == "--output")
+		{
+			outConfig.outputDirectory = value;
+			return true;
+		}
+		return false;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	spdlog::set_level(spdlog::level::warn);
+
+	TablebaseConfig config;
+	config.threadCount = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+	if (!ParseArguments(std::span<char*>(argv + 1, argc - 1), config))
+	{
+		std::cerr << s_usageText;
+		return 1;
+	}
+
+	Checkers::TablebaseGenerator generator(config.threadCount);
+	for (const Checkers::MaterialSignature& signature : Checkers::TablebaseGenerator::GetSignaturesUpTo(config.maxPieceCount))
+	{
+		Checkers::TablebaseGenerator::TableStats stats;
+		const Checkers::TablebaseGenerator::Table& table = generator.Generate(signature, stats);
+		if (!Checkers::TablebaseGenerator::WriteTable(table, config.outputDirectory))
+		{
+			std::cerr << "Couldn't write " << signature.ToString() << " to " << config.outputDirectory.string() << ".\n";
+			return 1;
+		}
+
+		std::cout << signature.ToString() << ": " << stats.positionCount << " positions, +" << stats.winCount << " ="
+			<< stats.drawCount << " -" << stats.lossCount << ", " << stats.passCount << " passes, "
+			<< stats.elapsed.count() << " ms\n";
+	}
+	return 0;
+}
@@ -0,0 +1,131 @@
+//---------------------------------------------------------------
+//
+// MatchStatistics.cpp
+//
+
+#include "MatchStatistics.h"
+
+#include <cmath>
+#include <limits>
+
+namespace Checkers {
+
+//===============================================================
+
+// Two-sided 95% quantile of the normal distribution.
+static constexpr double s_confidenceQuantile = 1.959963984540054;
+
+// Elo is a logistic scale: a 400 point difference is 10 to 1 odds.
+static constexpr double s_eloScale = 400.0;
+
+static double ToScoreRatio(double elo)
+{
+	return 1.0 / (1.0 + std::pow(10.0, -elo / s_eloScale));
+}
+
+static double ToElo(double scoreRatio)
+{
+	if (scoreRatio <= 0.0)
+	{
+		return -std::numeric_limits<double>::infinity();
+	}
+	if (scoreRatio >= 1.0)
+	{
+		return std::numeric_limits<double>::infinity();
+	}
+	return -s_eloScale * std::log10(1.0 / scoreRatio - 1.0);
+}
+
+// Variance of a single game's points around the mean score ratio.
+static double GetPerGameVariance(const MatchScore& score)
+{
+	const int32_t gameCount = score.GetGameCount();
+	if (gameCount == 0)
+	{
+		return 0.0;
+	}
+
+	const double scoreRatio = score.GetScoreRatio();
+	const double winDeviation = 1.0 - scoreRatio;
+	const double drawDeviation = 0.5 - scoreRatio;
+	const double lossDeviation = 0.0 - scoreRatio;
+	return (score.wins * winDeviation * winDeviation +
+		score.draws * drawDeviation * drawDeviation +
+		score.losses * lossDeviation * lossDeviation) / gameCount;
+}
+
+double MatchScore::GetScoreRatio() const
+{
+	const int32_t gameCount = GetGameCount();
+	return gameCount == 0 ? 0.5 : (wins + 0.5 * draws) / gameCount;
+}
+
+//===============================================================
+
+double MatchStatistics::GetEloDifference(const MatchScore& score)
+{
+	return ToElo(score.GetScoreRatio());
+}
+
+double MatchStatistics::GetEloErrorMargin(const MatchScore& score)
+{
+	const int32_t gameCount = score.GetGameCount();
+	if (gameCount == 0)
+	{
+		return 0.0;
+	}
+
+	const double scoreRatio = score.GetScoreRatio();
+	const double standardError = std::sqrt(GetPerGameVariance(score) / gameCount);
+	const double low = ToElo(scoreRatio - s_confidenceQuantile * standardError);
+	const double high = ToElo(scoreRatio + s_confidenceQuantile * standardError);
+	return (high - low) / 2.0;
+}
+
+double MatchStatistics::GetSprtLogLikelihoodRatio(const MatchScore& score, const SprtSettings& sprt)
+{
+	// Until there's been at least one decisive game and one that wasn't, there's no variance to go by.
+	const double variance = GetPerGameVariance(score);
+	if (variance <= 0.0)
+	{
+		return 0.0;
+	}
+
+	const double scoreRatio0 = ToScoreRatio(sprt.elo0);
+	const double scoreRatio1 = ToScoreRatio(sprt.elo1);
+	return score.GetGameCount() * (scoreRatio1 - scoreRatio0) *
+		(2.0 * score.GetScoreRatio() - scoreRatio0 - scoreRatio1) / (2.0 * variance);
+}
+
+double MatchStatistics::GetSprtLowerBound(const SprtSettings& sprt)
+{
+	return std::log(sprt.beta / (1.0 - sprt.alpha));
+}
+
+double MatchStatistics::GetSprtUpperBound(const SprtSettings& sprt)
+{
+	return std::log((1.0 - sprt.beta) / sprt.alpha);
+}
+
+SprtDecision MatchStatistics::GetSprtDecision(const MatchScore& score, const SprtSettings& sprt)
+{
+	if (!sprt.isEnabled)
+	{
+		return SprtDecision::Continue;
+	}
+
+	const double logLikelihoodRatio = GetSprtLogLikelihoodRatio(score, sprt);
+	if (logLikelihoodRatio >= GetSprtUpperBound(sprt))
+	{
+		return SprtDecision::AcceptH1;
+	}
+	if (logLikelihoodRatio <= GetSprtLowerBound(sprt))
+	{
+		return SprtDecision::AcceptH0;
+	}
+	return SprtDecision::Continue;
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,72 @@
+//---------------------------------------------------------------
+//
+// MatchStatistics.h
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+// Results of a match, from the first engine's point of view.
+struct MatchScore
+{
+	int32_t wins = 0;
+	int32_t draws = 0;
+	int32_t losses = 0;
+
+	int32_t GetGameCount() const { return wins + draws + losses; }
+
+	// Points per game, with a draw worth half. 0.5 when no games have been played.
+	double GetScoreRatio() const;
+};
+
+// What the SPRT has to say about a match so far.
+enum class SprtDecision : int32_t
+{
+	// Not enough evidence either way yet, keep playing.
+	Continue,
+
+	// The first engine is no stronger than elo0.
+	AcceptH0,
+
+	// The first engine is at least elo1 stronger.
+	AcceptH1
+};
+
+// Parameters of a sequential probability ratio test. Elo differences are from the first engine's point of view.
+struct SprtSettings
+{
+	bool isEnabled = false;
+	double elo0 = 0.0;
+	double elo1 = 0.0;
+	double alpha = 0.0;
+	double beta = 0.0;
+};
+
+namespace MatchStatistics {
+
+// The Elo difference a score ratio implies. Infinite for a perfect or zero score.
+double GetEloDifference(const MatchScore& score);
+
+// Half the width of the 95% confidence interval around GetEloDifference.
+double GetEloErrorMargin(const MatchScore& score);
+
+// Log-likelihood ratio of elo1 over elo0, using the normal approximation to the trinomial game outcomes.
+double GetSprtLogLikelihoodRatio(const MatchScore& score, const SprtSettings& sprt);
+
+// The LLR bounds that accept H0 (lower) and H1 (upper).
+double GetSprtLowerBound(const SprtSettings& sprt);
+double GetSprtUpperBound(const SprtSettings& sprt);
+
+// Whether the match can stop, and which way it went.
+SprtDecision GetSprtDecision(const MatchScore& score, const SprtSettings& sprt);
+
+}
+
+//===============================================================
+
+}
@@ -0,0 +1,321 @@
+//---------------------------------------------------------------
+//
+// Tournament.cpp
+//
+
+#include "Tournament.h"
+
+#include "checkers-core/GameState.h"
+#include "checkers-core/SearchEngine.h"
+#include "checkers-core/WorkStealingThreadPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+// Magic include needed for spdlog to log a custom type.
+// Must be included after spdlog.h. Thanks spdlog.
+#include <spdlog/fmt/ostr.h>
+
+namespace Checkers {
+
+//===============================================================
+
+static const char* ToString(SprtDecision decision)
+{
+	switch (decision)
+	{
+	case SprtDecision::AcceptH0:
+		return "H0 accepted";
+	case SprtDecision::AcceptH1:
+		return "H1 accepted";
+	case SprtDecision::Continue:
+	default:
+		return "undecided";
+	}
+}
+
+//---------------------------------------------------------------
+
+Tournament::Tournament(const TournamentConfig& config)
+	: m_config(config)
+	, m_threadPool(std::make_unique<WorkStealingThreadPool>(config.threadCount))
+{
+	// Each worker plays one game at a time, so its engines only ever need a single search thread.
+	m_workers.resize(m_threadPool->GetThreadCount());
+	for (TournamentWorker& worker : m_workers)
+	{
+		for (size_t engineIndex = 0; engineIndex < worker.engines.size(); ++engineIndex)
+		{
+			worker.engines[engineIndex] = std::make_unique<SearchEngine>(m_config.engines[engineIndex].hashMegabytes, 1);
+		}
+	}
+}
+
+Tournament::~Tournament() = default;
+
+bool Tournament::Initialize()
+{
+	m_openings.clear();
+	if (!m_config.openingsPath.empty())
+	{
+		if (!LoadOpenings(m_config.openingsPath))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		GameState gameState(nullptr);
+		gameState.ToggleTurnPlayer();
+		Opening line;
+		GenerateOpenings(gameState, std::max(m_config.openingDepth, 0), line);
+	}
+
+	spdlog::info("Tournament initialized. openings={} games={} threads={}",
+		m_openings.size(), m_config.gameCount, m_threadPool->GetThreadCount());
+	return !m_openings.empty();
+}
+
+MatchScore Tournament::Run()
+{
+	std::vector<WorkStealingThreadPool::Task> tasks;
+	tasks.reserve(m_config.gameCount);
+	for (int32_t gameIndex = 0; gameIndex < m_config.gameCount; ++gameIndex)
+	{
+		tasks.emplace_back([this, gameIndex](int32_t workerIndex)
+		{
+			if (m_isStopRequested.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			// Each opening is played twice with the colors swapped, so neither engine benefits from a lopsided one.
+			const Opening& opening = m_openings[(gameIndex / 2) % m_openings.size()];
+			RecordOutcome(PlayGame(m_workers[workerIndex], opening, gameIndex % 2));
+		});
+	}
+
+	m_threadPool->RunBatch(std::move(tasks));
+
+	std::scoped_lock lock(m_scoreMutex);
+	return m_score;
+}
+
+void Tournament::PrintReport(const MatchScore& score) const
+{
+	std::string reportText = fmt::format("Games {}: +{} ={} -{} | Score {:.1f}% | Elo {:.1f} +/- {:.1f}",
+		score.GetGameCount(), score.wins, score.draws, score.losses, score.GetScoreRatio() * 100.0,
+		MatchStatistics::GetEloDifference(score), MatchStatistics::GetEloErrorMargin(score));
+
+	if (m_config.sprt.isEnabled)
+	{
+		reportText += fmt::format(" | LLR {:.2f} [{:.2f}, {:.2f}] {}",
+			MatchStatistics::GetSprtLogLikelihoodRatio(score, m_config.sprt),
+			MatchStatistics::GetSprtLowerBound(m_config.sprt), MatchStatistics::GetSprtUpperBound(m_config.sprt),
+			ToString(MatchStatistics::GetSprtDecision(score, m_config.sprt)));
+	}
+
+	std::cout << reportText << "\n";
+}
+
+Tournament::GameOutcome Tournament::PlayGame(TournamentWorker& worker, const Opening& opening, int32_t redEngineIndex)
+{
+	GameState gameState(nullptr);
+	gameState.ToggleTurnPlayer();
+	for (const PackedCapturePath& move : opening)
+	{
+		if (gameState.GetWinState() != WinConditionReason::None)
+		{
+			break;
+		}
+		gameState.ApplyMove(move.ToGameMove());
+	}
+
+	std::array<std::chrono::milliseconds, 2> clocks = {
+		m_config.engines[0].timeControl.base,
+		m_config.engines[1].timeControl.base };
+
+	int32_t turnCount = static_cast<int32_t>(opening.size());
+	while (gameState.GetWinState() == WinConditionReason::None)
+	{
+		if (turnCount >= TournamentSettings::s_maxTurnsPerGame)
+		{
+			return GameOutcome::Draw;
+		}
+
+		const int32_t engineIndex = gameState.GetTurnPlayerId() == Identity::Red ? redEngineIndex : 1 - redEngineIndex;
+		const TournamentEngineSettings& engineSettings = m_config.engines[engineIndex];
+		const TimeControl& timeControl = engineSettings.timeControl;
+		std::chrono::milliseconds& clock = clocks[engineIndex];
+
+		SearchEngine::SearchLimits limits;
+		limits.maxDepth = engineSettings.maxDepth;
+		limits.maxTime = timeControl.HasClock() ?
+			std::max(clock / TournamentSettings::s_clockMovesToGo + timeControl.increment, std::chrono::milliseconds{ 1 }) :
+			timeControl.increment;
+
+		const auto startTime = std::chrono::steady_clock::now();
+		const SearchEngine::SearchResult result = worker.engines[engineIndex]->Search(gameState, limits);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+		if (timeControl.HasClock())
+		{
+			clock -= elapsed;
+			if (clock.count() < 0)
+			{
+				spdlog::warn("Engine lost on time. engine={} turn={} overrunMs={}", engineIndex, turnCount, -clock.count());
+				return engineIndex == 0 ? GameOutcome::FirstEngineLoss : GameOutcome::FirstEngineWin;
+			}
+			clock += timeControl.increment;
+		}
+
+#ifdef DEBUG
+		// The game ends as soon as the turn player is out of moves, so there's always one to play here.
+		assert(result.hasMove);
+#endif
+		gameState.ApplyMove(result.bestMove);
+		++turnCount;
+	}
+
+	const Identity winnerId = gameState.GetWinnerId();
+	if (winnerId == Identity::Neutral)
+	{
+		return GameOutcome::Draw;
+	}
+
+	const int32_t winnerEngineIndex = winnerId == Identity::Red ? redEngineIndex : 1 - redEngineIndex;
+	return winnerEngineIndex == 0 ? GameOutcome::FirstEngineWin : GameOutcome::FirstEngineLoss;
+}
+
+void Tournament::RecordOutcome(GameOutcome outcome)
+{
+	std::scoped_lock lock(m_scoreMutex);
+
+	// Games already running when the SPRT decided still finish, but they don't count.
+	if (m_sprtDecision != SprtDecision::Continue)
+	{
+		return;
+	}
+
+	switch (outcome)
+	{
+	case GameOutcome::FirstEngineWin:
+		++m_score.wins;
+		break;
+	case GameOutcome::FirstEngineLoss:
+		++m_score.losses;
+		break;
+	case GameOutcome::Draw:
+	default:
+		++m_score.draws;
+		break;
+	}
+
+	if (m_score.GetGameCount() % TournamentSettings::s_reportInterval == 0)
+	{
+		PrintReport(m_score);
+	}
+
+	m_sprtDecision = MatchStatistics::GetSprtDecision(m_score, m_config.sprt);
+	if (m_sprtDecision != SprtDecision::Continue)
+	{
+		m_isStopRequested.store(true, std::memory_order_relaxed);
+	}
+}
+
+bool Tournament::LoadOpenings(const std::string& path)
+{
+	std::ifstream openingsFile(path);
+	if (!openingsFile)
+	{
+		spdlog::error("Could not open openings file. path={}", path);
+		return false;
+	}
+
+	std::string text;
+	int32_t lineNumber = 0;
+	while (std::getline(openingsFile, text))
+	{
+		++lineNumber;
+
+		// Blank lines and # comments are skipped.
+		text.erase(std::find(text.begin(), text.end(), '#'), text.end());
+		if (std::ranges::all_of(text, [](char c) { return std::isspace(static_cast<unsigned char>(c)); }))
+		{
+			continue;
+		}
+
+		Opening opening;
+		if (!ParseOpening(text, opening))
+		{
+			spdlog::error("Illegal opening. path={} line={} text={}", path, lineNumber, text);
+			return false;
+		}
+		m_openings.push_back(std::move(opening));
+	}
+
+	return true;
+}
+
+void Tournament::GenerateOpenings(GameState& gameState, int32_t depth, Opening& line)
+{
+	if (depth == 0)
+	{
+		m_openings.push_back(line);
+		return;
+	}
+
+	std::vector<GameMove> moves;
+	gameState.GetLegalMoves(moves);
+	for (const GameMove& move : moves)
+	{
+		line.push_back(PackedCapturePath::FromGameMove(move));
+		gameState.MakeMove(move);
+		GenerateOpenings(gameState, depth - 1, line);
+		gameState.UnmakeMove();
+		line.pop_back();
+	}
+}
+
+bool Tournament::ParseOpening(const std::string& text, Opening& outOpening)
+{
+	GameState gameState(nullptr);
+	gameState.ToggleTurnPlayer();
+
+	std::istringstream moveStream(text);
+	std::string moveText;
+	std::vector<GameMove> moves;
+	while (moveStream >> moveText)
+	{
+		if (gameState.GetWinState() != WinConditionReason::None)
+		{
+			return false;
+		}
+
+		// Moves are matched on their notation, so a capture chain has to be written out in full, e.g. "9x18x25".
+		moves.clear();
+		gameState.GetLegalMoves(moves);
+		const auto it = std::ranges::find_if(moves, [&moveText](const GameMove& move)
+		{
+			return fmt::format("{}", move) == moveText;
+		});
+
+		if (it == moves.end())
+		{
+			return false;
+		}
+
+		outOpening.push_back(PackedCapturePath::FromGameMove(*it));
+		gameState.ApplyMove(*it);
+	}
+
+	return true;
+}
+
+//===============================================================
+
+}
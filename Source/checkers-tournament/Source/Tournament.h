@@ -0,0 +1,150 @@
+//---------------------------------------------------------------
+//
+// Tournament.h
+//
+
+#pragma once
+
+#include "MatchStatistics.h"
+#include "TournamentSettings.h"
+
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/GameTypes.h"
+#include "checkers-core/PackedMove.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Checkers {
+
+//===============================================================
+
+// How long one side of a game may think.
+struct TimeControl
+{
+	// Starting time on the clock. Zero means there's no clock, and every move gets the increment to think.
+	std::chrono::milliseconds base{ 0 };
+
+	// Added to the clock after every move, or the think time per move when there's no clock.
+	std::chrono::milliseconds increment{ TournamentSettings::s_defaultMoveTimeMilliseconds };
+
+	bool HasClock() const { return base.count() > 0; }
+};
+
+// How one of the engines in a match plays.
+struct TournamentEngineSettings
+{
+	TimeControl timeControl;
+	int32_t maxDepth = SearchSettings::s_defaultMaxDepth;
+	size_t hashMegabytes = TournamentSettings::s_defaultHashMegabytes;
+};
+
+// Everything that describes a match.
+struct TournamentConfig
+{
+	// The first engine is the one being tested. Every score, Elo and SPRT is from its point of view.
+	std::array<TournamentEngineSettings, 2> engines;
+
+	// Most games the match will play.
+	int32_t gameCount = TournamentSettings::s_defaultGameCount;
+
+	// Games played at once, one per worker thread.
+	int32_t threadCount = 1;
+
+	// A file of openings, one per line, in checkers notation (e.g. "22-18 11-15 18x11"). When empty, every position
+	// openingDepth turns in from the start is used instead.
+	std::string openingsPath;
+	int32_t openingDepth = TournamentSettings::s_defaultOpeningDepth;
+
+	SprtSettings sprt;
+};
+
+class GameState;
+class SearchEngine;
+class WorkStealingThreadPool;
+
+// Plays engine vs engine games on every worker thread at once. Games are played headless on GameState with the
+// full rules of the game, so they end exactly the way a game in the console does: all pieces captured, no moves
+// left, or a position repeated three times. Every opening is played twice with the engines swapping colors.
+class Tournament
+{
+public:
+	Tournament(const Tournament& other) = delete;
+	Tournament& operator=(const Tournament& other) = delete;
+	Tournament(Tournament&& other) noexcept = delete;
+	Tournament& operator=(Tournament&& other) noexcept = delete;
+
+	Tournament(const TournamentConfig& config);
+	~Tournament();
+
+	// Loads or generates the openings. Returns false if there's nothing to play.
+	bool Initialize();
+
+	// Plays games until the game count is reached or the SPRT makes a decision, printing progress along the way.
+	// Returns the final score.
+	MatchScore Run();
+
+	// Prints a one line summary of the score, Elo and SPRT state.
+	void PrintReport(const MatchScore& score) const;
+
+private:
+
+	// A sequence of whole turns from the start position, packed since generated openings can run into the thousands.
+	using Opening = std::vector<PackedCapturePath>;
+
+	enum class GameOutcome : int32_t
+	{
+		FirstEngineWin,
+		Draw,
+		FirstEngineLoss
+	};
+
+	// Per-worker engines, so games never share search state.
+	struct TournamentWorker
+	{
+		// Indexed the same as the config's engines.
+		std::array<std::unique_ptr<SearchEngine>, 2> engines;
+	};
+
+	// Plays one game out from the opening. redEngineIndex says which engine plays red.
+	GameOutcome PlayGame(TournamentWorker& worker, const Opening& opening, int32_t redEngineIndex);
+
+	// Adds a finished game to the score and checks whether the match can stop.
+	void RecordOutcome(GameOutcome outcome);
+
+	// Reads the openings file. Returns false if it can't be read or any opening isn't legal.
+	bool LoadOpenings(const std::string& path);
+
+	// Adds every line depth turns deep from the state's position to the openings.
+	void GenerateOpenings(GameState& gameState, int32_t depth, Opening& line);
+
+	// Parses one line of an openings file. Returns false if any move isn't legal in its position.
+	static bool ParseOpening(const std::string& text, Opening& outOpening);
+
+	TournamentConfig m_config;
+
+	std::vector<Opening> m_openings;
+
+	std::unique_ptr<WorkStealingThreadPool> m_threadPool;
+
+	// One per pool thread, indexed by worker index.
+	std::vector<TournamentWorker> m_workers;
+
+	// Guards the score and the SPRT decision.
+	std::mutex m_scoreMutex;
+	MatchScore m_score;
+	SprtDecision m_sprtDecision = SprtDecision::Continue;
+
+	// Raised once the SPRT decides. Games that haven't started yet are skipped.
+	std::atomic<bool> m_isStopRequested = false;
+};
+
+//===============================================================
+
+}
@@ -0,0 +1,50 @@
+//---------------------------------------------------------------
+//
+// TournamentSettings.h
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Checkers {
+
+//===============================================================
+
+struct TournamentSettings {
+
+	// Games played when nothing else is asked for. An SPRT can stop the match well before this.
+	static constexpr int32_t s_defaultGameCount = 20000;
+
+	// How long an engine may think about each move, in milliseconds, when it isn't given a time control.
+	static constexpr int32_t s_defaultMoveTimeMilliseconds = 100;
+
+	// Transposition table size per engine, in megabytes. Every worker runs two engines, so this adds up quickly.
+	static constexpr size_t s_defaultHashMegabytes = 16;
+
+	// Without an openings file, every position this many turns in from the start is used as an opening.
+	static constexpr int32_t s_defaultOpeningDepth = 3;
+
+	// A game still going after this many turns is adjudicated a draw. Kings can shuffle around for a very long time
+	// without ever repeating a position three times.
+	static constexpr int32_t s_maxTurnsPerGame = 300;
+
+	// With a clock running, each move is budgeted the remaining time over this, plus the increment.
+	static constexpr int32_t s_clockMovesToGo = 30;
+
+	// The default SPRT tests whether the first engine is at least s_defaultSprtElo1 stronger (H1) or no stronger (H0).
+	static constexpr double s_defaultSprtElo0 = 0.0;
+	static constexpr double s_defaultSprtElo1 = 5.0;
+
+	// Default false positive and false negative rates of the SPRT.
+	static constexpr double s_defaultSprtAlpha = 0.05;
+	static constexpr double s_defaultSprtBeta = 0.05;
+
+	// A progress report is printed every this many finished games.
+	static constexpr int32_t s_reportInterval = 100;
+};
+
+//===============================================================
+
+}
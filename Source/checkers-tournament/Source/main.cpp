@@ -0,0 +1,143 @@
+#include "MatchStatistics.h"
+#include "Tournament.h"
+#include "TournamentSettings.h"
+
+#include "checkers-core/CommandLine.h"
+
+#include <algorithm>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+static constexpr std::string_view s_usageText =
+	"Usage: checkers-tournament [options]\n"
+	"  --games N             Most games to play.\n"
+	"  --threads N           Games played at once. Defaults to every core.\n"
+	"  --openings FILE       One opening per line in checkers notation, e.g. \"22-18 11-15\".\n"
+	"  --opening-depth N     Without an openings file, use every position N turns in.\n"
+	"  --tc1 / --tc2 TC      Time control of the first/second engine, in ms. Either a fixed time per\n"
+	"                        move (\"100\") or a clock with an increment (\"10000+100\").\n"
+	"  --depth1 / --depth2 N Most plies the first/second engine searches.\n"
+	"  --hash1 / --hash2 MB  Transposition table size of the first/second engine, per worker.\n"
+	"  --sprt ELO0 ELO1      Stop as soon as an SPRT between these Elo differences decides.\n"
+	"  --alpha A / --beta B  SPRT error rates.\n";
+
+using Checkers::CommandLine::ParseNumber;
+using Checkers::CommandLine::ParsePositiveInt;
+
+// Accepts "MOVETIME" or "BASE+INCREMENT", in milliseconds.
+static bool ParseTimeControl(std::string_view text, Checkers::TimeControl& outTimeControl)
+{
+	int32_t base = 0;
+	int32_t increment = 0;
+	const size_t plusPosition = text.find('+');
+	if (plusPosition == std::string_view::npos)
+	{
+		if (!ParsePositiveInt(text, increment))
+		{
+			return false;
+		}
+	}
+	else if (!ParsePositiveInt(text.substr(0, plusPosition), base) || !ParseNumber(text.substr(plusPosition + 1), increment) ||
+		increment < 0)
+	{
+		return false;
+	}
+
+	outTimeControl.base = std::chrono::milliseconds{ base };
+	outTimeControl.increment = std::chrono::milliseconds{ increment };
+	return true;
+}
+
+static bool ParseArguments(std::span<char*> arguments, Checkers::TournamentConfig& outConfig)
+{
+	return Checkers::CommandLine::ParseOptions(arguments,
+		[&outConfig](std::string_view option, std::string_view value, Checkers::CommandLine::ArgumentReader& reader)
+	{
+		if (option == "--games")
+		{
+			return ParsePositiveInt(value, outConfig.gameCount);
+		}
+		if (option == "--threads")
+		{
+			return ParsePositiveInt(value, outConfig.threadCount);
+		}
+		if (option == "--openings")
+		{
+			outConfig.openingsPath = value;
+			return true;
+		}
+		if (option == "--opening-depth")
+		{
+			return ParseNumber(value, outConfig.openingDepth) && outConfig.openingDepth >= 0;
+		}
+		if (option == "--tc1" || option == "--tc2")
+		{
+			return ParseTimeControl(value, outConfig.engines[option.back() - '1'].timeControl);
+		}
+		if (option == "--depth1" || option == "--depth2")
+		{
+			return ParsePositiveInt(value, outConfig.engines[option.back() - '1'].maxDepth);
+		}
+		if (option == "--hash1" || option == "--hash2")
+		{
+			int32_t hashMegabytes = 0;
+			const bool isValid = ParsePositiveInt(value, hashMegabytes);
+			outConfig.engines[option.back() - '1'].hashMegabytes = hashMegabytes;
+			return isValid;
+		}
+		if (option == "--sprt")
+		{
+			std::string_view elo1Text;
+			outConfig.sprt.isEnabled = true;
+			return reader.TryTakeNext(elo1Text) && ParseNumber(value, outConfig.sprt.elo0) &&
+				ParseNumber(elo1Text, outConfig.sprt.elo1) && outConfig.sprt.elo0 < outConfig.sprt.elo1;
+		}
+		if (option == "--alpha")
+		{
+			return ParseNumber(value, outConfig.sprt.alpha) && outConfig.sprt.alpha > 0.0 && outConfig.sprt.alpha < 1.0;
+		}
+		if (option == "--beta")
+		{
+			return ParseNumber(value, outConfig.sprt.beta) && outConfig.sprt.beta > 0.0 && outConfig.sprt.beta < 1.0;
+		}
+		return false;
+	});
+}
+
+int main(int argc, char* argv[])
+{
+	// Game and search code log every turn at info level. Across every core, that would serialize the workers on the
+	// logger and drown out the report.
+	spdlog::set_level(spdlog::level::warn);
+
+	Checkers::TournamentConfig config;
+	config.threadCount = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+	config.sprt.elo0 = Checkers::TournamentSettings::s_defaultSprtElo0;
+	config.sprt.elo1 = Checkers::TournamentSettings::s_defaultSprtElo1;
+	config.sprt.alpha = Checkers::TournamentSettings::s_defaultSprtAlpha;
+	config.sprt.beta = Checkers::TournamentSettings::s_defaultSprtBeta;
+
+	if (!ParseArguments(std::span<char*>(argv + 1, argc - 1), config))
+	{
+		std::cerr << s_usageText;
+		return 1;
+	}
+
+	Checkers::Tournament tournament(config);
+	if (!tournament.Initialize())
+	{
+		std::cerr << "No openings to play.\n";
+		return 1;
+	}
+
+	const Checkers::MatchScore score = tournament.Run();
+
+	std::cout << "Final: ";
+	tournament.PrintReport(score);
+	return 0;
+}
@@ -5,9 +5,10 @@
 
 #include "CheckersNotationView.h"
 
-#include "GameSettings.h"
 #include "UITextStrings.h"
-#include "Utility.h"
+
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/Utility.h"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/bundled/format.h>
@@ -5,10 +5,11 @@
 
 #include "ChessLikeView.h"
 
-#include "GameSettings.h"
-#include "GameTypes.h"
 #include "UITextStrings.h"
-#include "Utility.h"
+
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/GameTypes.h"
+#include "checkers-core/Utility.h"
 
 #include <spdlog/spdlog.h>
 
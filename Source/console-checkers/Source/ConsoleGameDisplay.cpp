@@ -6,10 +6,14 @@
 #include "ConsoleGameDisplay.h"
 
 #include "IGameBoardViewStrategy.h"
-#include "IGameStateDisplayInfo.h"
-#include "UIEvents.h"
 #include "UITextStrings.h"
 
+#include "checkers-core/IGameStateDisplayInfo.h"
+#include "checkers-core/PerftEngine.h"
+#include "checkers-core/Trace.h"
+#include "checkers-core/UIEvents.h"
+
+#include <algorithm>
 #include <iostream>
 #include <ranges>
 
@@ -78,6 +82,7 @@ void ConsoleGameDisplay::Initialize(IGameStateDisplayInfo* displayData, UIEvents
 	events.GetTurnChangedEvent().subscribe(
 		[this]()
 	{
+		CHECKERS_TRACE(Display, "Redrawing for turn change. turnPlayer={}", m_gameStateInfo->GetTurnPlayerId());
 		const std::string gameUI = fmt::format("\n{}\n{}",
 		"-------------------------------------",
 		GetFullGameDisplayText());
@@ -100,6 +105,7 @@ void ConsoleGameDisplay::Initialize(IGameStateDisplayInfo* displayData, UIEvents
 	events.GetAdditionalPieceCaptureRequiredEvent().subscribe(
 		[this]()
 	{
+		CHECKERS_TRACE(Display, "Redrawing for additional capture. turnPlayer={}", m_gameStateInfo->GetTurnPlayerId());
 		const std::string gameUI = fmt::format("\n{}\n{}\nAn additional capture is required!\n",
 			"-------------------------------------",
 			GetFullGameDisplayText());
@@ -151,6 +157,22 @@ void ConsoleGameDisplay::Initialize(IGameStateDisplayInfo* displayData, UIEvents
 		std::cout << gameUI;
 	});
 
+	events.GetPerftCompletedEvent().subscribe(
+		[this](const PerftResult& result)
+	{
+		std::string perftText = fmt::format("\nPerft depth {}\n", result.depth);
+		for (const PerftResult::RootMoveCount& rootMoveCount : result.rootMoveCounts)
+		{
+			perftText += fmt::format("  {}: {}\n", rootMoveCount.move, rootMoveCount.nodes);
+		}
+
+		// Guard against a count too quick for the clock to see.
+		const double elapsedSeconds = std::max(result.elapsed.count(), int64_t{ 1 }) / 1000.0;
+		perftText += fmt::format("Nodes: {} | Time: {}ms | Nodes/sec: {:.0f}\n",
+			result.nodes, result.elapsed.count(), result.nodes / elapsedSeconds);
+		std::cout << perftText;
+	});
+
 	m_isInitialized = true;
 }
 
@@ -164,8 +186,10 @@ std::string ConsoleGameDisplay::GetGameBoardDisplay() const
 	assert(m_gameBoardView);
 #endif
 
-	return m_gameBoardView->GetGameBoardDisplayText(m_gameStateInfo->GetGameBoardData(),
-		m_gameStateInfo->GetBestHintIndices());
+	const std::vector<int32_t> hintIndices = m_gameStateInfo->GetBestHintIndices();
+	CHECKERS_TRACE(Display, "Drawing game board. view={} hints={}", m_gameBoardView->GetId(), hintIndices);
+
+	return m_gameBoardView->GetGameBoardDisplayText(m_gameStateInfo->GetGameBoardData(), hintIndices);
 }
 
 std::string ConsoleGameDisplay::GetFullGameDisplayText() const
@@ -10,6 +10,8 @@
 #include "Game.h"
 #include "UITextStrings.h"
 
+#include "checkers-core/Trace.h"
+
 #include <functional>
 #include <iostream>
 #include <ranges>
@@ -26,6 +28,8 @@ static constexpr unsigned char s_helpCommandId = 'h';
 static constexpr unsigned char s_changeStyleCommandId = 's';
 static constexpr unsigned char s_moveCommandId = 'm';
 static constexpr unsigned char s_hintCommand = 'i';
+static constexpr unsigned char s_computerOpponentCommandId = 'c';
+static constexpr unsigned char s_perftCommandId = 'p';
 
 struct CommandResult {
 	CommandResult(const CommandResult& other) = delete;
@@ -96,6 +100,42 @@ public:
 				args[MoveCommand::Settings::s_sourceArgPosition],
 				args[MoveCommand::Settings::s_destinationArgPosition]) };
 		};
+
+		// Register the computer opponent command.
+		m_commandRegistry[s_computerOpponentCommandId] =
+			[](const std::vector<std::string>& args) -> CommandResult
+		{
+			if (args.size() < ComputerOpponentCommand::Settings::s_requiredArgumentCount ||
+				args.size() > ComputerOpponentCommand::Settings::s_maxArgumentCount)
+			{
+				return { nullptr, UIText::s_errorCommandReasonInvalidArument.data() };
+			}
+
+			const bool hasThinkTime = args.size() > ComputerOpponentCommand::Settings::s_thinkTimeArgPosition;
+			const bool hasThreadCount = args.size() > ComputerOpponentCommand::Settings::s_threadCountArgPosition;
+			return { std::make_unique<ComputerOpponentCommand>(
+				args[ComputerOpponentCommand::Settings::s_playerArgPosition],
+				hasThinkTime ? args[ComputerOpponentCommand::Settings::s_thinkTimeArgPosition] : std::string{},
+				hasThreadCount ? args[ComputerOpponentCommand::Settings::s_threadCountArgPosition] : std::string{}) };
+		};
+
+		// Register the perft command.
+		m_commandRegistry[s_perftCommandId] =
+			[](const std::vector<std::string>& args) -> CommandResult
+		{
+			if (args.size() < PerftCommand::Settings::s_requiredArgumentCount ||
+				args.size() > PerftCommand::Settings::s_maxArgumentCount)
+			{
+				return { nullptr, UIText::s_errorCommandReasonInvalidArument.data() };
+			}
+
+			const bool hasThreadCount = args.size() > PerftCommand::Settings::s_threadCountArgPosition;
+			const bool hasHashMegabytes = args.size() > PerftCommand::Settings::s_hashMegabytesArgPosition;
+			return { std::make_unique<PerftCommand>(
+				args[PerftCommand::Settings::s_depthArgPosition],
+				hasThreadCount ? args[PerftCommand::Settings::s_threadCountArgPosition] : std::string{},
+				hasHashMegabytes ? args[PerftCommand::Settings::s_hashMegabytesArgPosition] : std::string{}) };
+		};
 	}
 
 	~CommandFactory() = default;
@@ -158,19 +198,19 @@ void ConsoleInputComponent::RequestAndProcessInput() const
 	const auto commandResult = m_commandFactory->CreateCommand(commandId, args);
 	if (!commandResult.command)
 	{
-		spdlog::info("Failed to create command, it will not be executed. commandId={} input={}", commandId, sanitizedInput);
+		CHECKERS_TRACE(Input, "Failed to create command, it will not be executed. commandId={} input={}", commandId, sanitizedInput);
 		ReportError(commandId, commandResult.errorReason);
 	}
 	else if (commandResult.command->IsCanceled())
 	{
-		spdlog::info("Skipped execution of canceled command. commandId={} input={}", commandId, sanitizedInput);
+		CHECKERS_TRACE(Input, "Skipped execution of canceled command. commandId={} input={}", commandId, sanitizedInput);
 		ReportError(commandId, commandResult.command->GetErrorInfo().errorReason);
 	}
 	else
 	{
 		if (!commandResult.command->Execute(m_game))
 		{
-			spdlog::info("Failed to execute command. commandId={} input={}", commandId, sanitizedInput);
+			CHECKERS_TRACE(Input, "Failed to execute command. commandId={} input={}", commandId, sanitizedInput);
 			ReportError(commandId, commandResult.command->GetErrorInfo().errorReason);
 		}
 	}
@@ -221,6 +261,16 @@ std::string ConsoleInputComponent::GetCommandInfoStringFromId(unsigned char comm
 			m_game->GetSelectedGameBoardViewStrategy()->GetMoveCommandSyntax());
 	}
 
+	if (commandId == s_computerOpponentCommandId)
+	{
+		return fmt::format(UIText::s_errorCommandComputer.data(), reason);
+	}
+
+	if (commandId == s_perftCommandId)
+	{
+		return fmt::format(UIText::s_errorCommandPerft.data(), reason);
+	}
+
 	return UIText::s_errorCommandUnknown.data();
 }
 
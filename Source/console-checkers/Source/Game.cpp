@@ -8,9 +8,15 @@
 #include "CheckersNotationView.h"
 #include "ChessLikeView.h"
 #include "ConsoleInputComponent.h"
-#include "GameSettings.h"
-#include "GameState.h"
-#include "GameTypes.h"
+
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/GameState.h"
+#include "checkers-core/GameTypes.h"
+#include "checkers-core/OpeningBook.h"
+#include "checkers-core/PerftEngine.h"
+#include "checkers-core/SearchEngine.h"
+#include "checkers-core/TablebaseProber.h"
+#include "checkers-core/Utility.h"
 
 #include <spdlog/spdlog.h>
 
@@ -18,6 +24,9 @@
 // Must be included after spdlog.h. Thanks spdlog.
 #include <spdlog/fmt/ostr.h>
 
+#include <filesystem>
+#include <thread>
+
 namespace Checkers {
 
 //===============================================================
@@ -86,9 +95,28 @@ IGameBoardViewStrategy* GameBoardViewStrategyRegistry::GetGameBoardViewStrategyF
 
 Game::Game()
 	: m_inputComponent(std::make_unique<ConsoleInputComponent>(this))
-	, m_gameState(std::make_unique<GameState>(this))
+	, m_gameState(std::make_unique<GameState>(&m_uiPromptRequestedEvents))
+	, m_tablebase(std::make_unique<TablebaseProber>())
+	, m_openingBook(std::make_unique<OpeningBook>())
+	, m_searchEngine(std::make_unique<SearchEngine>(SearchSettings::s_transpositionTableMegabytes,
+		static_cast<int32_t>(std::thread::hardware_concurrency())))
 	, m_gameBoardViewStrategyRegistry(std::make_unique<GameBoardViewStrategyRegistry>())
 {
+	// Tablebases are optional, checkers-tablebase builds them. The files are only mapped, so this is quick.
+	std::error_code errorCode;
+	if (std::filesystem::is_directory(TablebaseSettings::s_defaultDirectory, errorCode) &&
+		m_tablebase->Open(TablebaseSettings::s_defaultDirectory) > 0)
+	{
+		m_searchEngine->SetTablebase(m_tablebase.get());
+	}
+
+	// Same for the opening book, checkers-book builds it.
+	if (std::filesystem::is_regular_file(OpeningBookSettings::s_defaultPath, errorCode) &&
+		m_openingBook->Open(OpeningBookSettings::s_defaultPath))
+	{
+		m_searchEngine->SetOpeningBook(m_openingBook.get());
+	}
+
 	m_selectedGameBoardViewStrategy = m_gameBoardViewStrategyRegistry->GetGameBoardViewStrategyForId(
 		GameplaySettings::s_defaultGameBoardViewStrategy);
 
@@ -126,6 +154,12 @@ void Game::Run()
 
 	while (m_gameState->GetWinState() == WinConditionReason::None)
 	{
+		if (IsComputerControlled(m_gameState->GetTurnPlayerId()))
+		{
+			PlayComputerTurn();
+			continue;
+		}
+
 		// From here out our game is purely event driven. We simply have an input/command loop
 		// which we delegate to the right places via events until the game is done.
 		m_inputComponent->RequestAndProcessInput();
@@ -134,9 +168,85 @@ void Game::Run()
 
 void Game::DisplayPlayerHints()
 {
+	// In a well known opening, the book's favourite move makes a better hint than the biggest capture.
+	if (m_openingBook->IsOpen() && !m_gameState->HasPlayerTouchedPiece())
+	{
+		std::vector<GameMove> moves;
+		m_gameState->GetLegalMoves(moves);
+
+		GameMove bookMove;
+		if (m_openingBook->TryGetMove(m_gameState->GetZobristKey(), moves, 0, bookMove))
+		{
+			m_gameState->ScopedActivateHintsAndNotify(bookMove);
+			return;
+		}
+	}
+
 	m_gameState->ScopedActivateHintsAndNotify();
 }
 
+void Game::ToggleComputerControlled(Identity playerId)
+{
+	if (m_computerControlledPlayers.erase(playerId) == 0)
+	{
+		m_computerControlledPlayers.insert(playerId);
+	}
+
+	spdlog::info("Computer control toggled. player={} isComputerControlled={}", playerId, IsComputerControlled(playerId));
+}
+
+void Game::SetComputerThinkTime(std::chrono::milliseconds thinkTime)
+{
+	m_computerThinkTime = thinkTime;
+}
+
+void Game::SetComputerThreadCount(int32_t threadCount)
+{
+	m_searchEngine->SetThreadCount(threadCount);
+}
+
+void Game::RunPerft(int32_t depth, int32_t threadCount, size_t hashMegabytes)
+{
+	PerftEngine perftEngine(threadCount, hashMegabytes);
+	const PerftResult result = perftEngine.Run(*m_gameState, depth);
+	m_uiPromptRequestedEvents.GetPerftCompletedEvent().notify(result);
+}
+
+void Game::PlayComputerTurn()
+{
+	const SearchEngine::SearchResult result = m_searchEngine->Search(*m_gameState, { m_computerMaxDepth, m_computerThinkTime });
+	if (!result.hasMove)
+	{
+#ifdef DEBUG
+		// A player with no moves has already lost, the game loop shouldn't have asked for a turn.
+		assert(false);
+#endif
+		spdlog::error("Computer was asked to play a turn with no moves available. player={}", m_gameState->GetTurnPlayerId());
+		return;
+	}
+
+	// Play the turn out one step at a time through the same path the player's move command takes, so the rules,
+	// events and bookkeeping all happen exactly like they would for a human.
+	const GameMove& move = result.bestMove;
+	if (!move.IsCapture())
+	{
+		MovePiece({ Utility::ToGameBoardIndexFromSquare(move.sourceSquare), Utility::ToGameBoardIndexFromSquare(move.destSquare) });
+		return;
+	}
+
+	int32_t stepSourceSquare = move.sourceSquare;
+	for (int32_t jump = 0; jump < move.captureCount; ++jump)
+	{
+		const int32_t stepDestSquare = move.jumpPath[jump];
+		MovePiece({ Utility::ToGameBoardIndexFromSquare(stepSourceSquare), Utility::ToGameBoardIndexFromSquare(stepDestSquare) });
+		if (m_gameState->GetWinState() != WinConditionReason::None)
+		{
+			return;
+		}
+		stepSourceSquare = stepDestSquare;
+	}
+}
+
 //===============================================================
 
 }
@@ -5,10 +5,13 @@
 
 #pragma once
 
-#include "GameTypes.h"
-#include "UIEvents.h"
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/GameTypes.h"
+#include "checkers-core/UIEvents.h"
 
+#include <chrono>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace Checkers {
@@ -19,6 +22,9 @@ class ConsoleGameDisplay;
 class ConsoleInputComponent;
 class GameState;
 class IGameBoardViewStrategy;
+class OpeningBook;
+class SearchEngine;
+class TablebaseProber;
 
 class GameBoardViewStrategyRegistry
 {
@@ -80,14 +86,50 @@ public:
 	// Activates hints on the game state and notifies the display.
 	void DisplayPlayerHints();
 
+	// Hands control of the given player over to the computer, or back to the console if it already had it.
+	void ToggleComputerControlled(Identity playerId);
+
+	// Returns true if the computer makes the moves for the given player.
+	bool IsComputerControlled(Identity playerId) const { return m_computerControlledPlayers.contains(playerId); }
+
+	// Sets how long the computer may think about each of its turns.
+	void SetComputerThinkTime(std::chrono::milliseconds thinkTime);
+
+	// Sets how many threads the computer searches with.
+	void SetComputerThreadCount(int32_t threadCount);
+
+	// Counts every position depth turns ahead of the current one and notifies the display with the breakdown.
+	void RunPerft(int32_t depth, int32_t threadCount, size_t hashMegabytes);
+
 private:
 
+	// Searches for the turn player's best move and plays it out, one step at a time, like a player would.
+	void PlayComputerTurn();
+
 	// InputComponent handles input and delegates commands to where they need to go.
 	std::unique_ptr<ConsoleInputComponent> m_inputComponent = nullptr;
 
 	// Holds the entire state of the game, including the board, player turn, etc.
 	std::unique_ptr<GameState> m_gameState = nullptr;
 
+	// Endgame databases the computer probes, if any were found at startup. Declared before m_searchEngine, which
+	// refers to it.
+	std::unique_ptr<TablebaseProber> m_tablebase = nullptr;
+
+	// Book the computer opens from, and hints suggest from, if one was found at startup. Also referred to by
+	// m_searchEngine.
+	std::unique_ptr<OpeningBook> m_openingBook = nullptr;
+
+	// Picks moves for any computer controlled player.
+	std::unique_ptr<SearchEngine> m_searchEngine = nullptr;
+
+	// Players whose turns are played by m_searchEngine instead of read from the console.
+	std::unordered_set<Identity> m_computerControlledPlayers;
+
+	// Depth and time limits the computer searches with.
+	int32_t m_computerMaxDepth = SearchSettings::s_defaultMaxDepth;
+	std::chrono::milliseconds m_computerThinkTime{ SearchSettings::s_defaultMaxTimeMilliseconds };
+
 	// Registry of our available view strategies.
 	std::unique_ptr<GameBoardViewStrategyRegistry> m_gameBoardViewStrategyRegistry = nullptr;
 
@@ -9,15 +9,42 @@
 #include "IGameBoardViewStrategy.h"
 #include "UITextStrings.h"
 
+#include "checkers-core/Trace.h"
+
 #include <spdlog/spdlog.h>
 // Magic include needed for spdlog to log a custom type.
 // Must be included after spdlog.h. Thanks spdlog.
 #include <spdlog/fmt/ostr.h>
 
+#include <thread>
+
 namespace Checkers {
 
 //===============================================================
 
+// Parses a whole, positive number into outValue. An empty input is allowed and leaves outValue alone, anything else
+// that isn't a whole, positive number fails.
+static bool ParseOptionalPositiveArgument(const std::string& input, int32_t& outValue)
+{
+	if (input.empty())
+	{
+		return true;
+	}
+
+	int32_t value = 0;
+	const char* inputEnd = input.data() + input.size();
+	auto [inputAfterParse, ec] = std::from_chars(input.data(), inputEnd, value);
+	if (ec != std::errc() || inputAfterParse != inputEnd || value <= 0)
+	{
+		return false;
+	}
+
+	outValue = value;
+	return true;
+}
+
+//--------------------------------------------------------------
+
 ICommand::~ICommand() = default;
 
 //--------------------------------------------------------------
@@ -174,7 +201,7 @@ bool MoveCommand::Execute(Game* game)
 	}
 
 	PieceMoveDescription pieceMoveDescription{ sourceIndex, destinationIndex };
-	spdlog::info("Player wants to make a move. MoveDescription={}", pieceMoveDescription);
+	CHECKERS_TRACE(Input, "Player wants to make a move. MoveDescription={}", pieceMoveDescription);
 
 	game->MovePiece(pieceMoveDescription);
 
@@ -191,6 +218,100 @@ const CommandErrorInfo& MoveCommand::GetErrorInfo()
 	return m_errorInfo;
 }
 
+//--------------------------------------------------------------
+
+ComputerOpponentCommand::~ComputerOpponentCommand() = default;
+
+ComputerOpponentCommand::ComputerOpponentCommand(const std::string& playerInput, const std::string& thinkTimeInput,
+	const std::string& threadCountInput)
+{
+	if (playerInput == "r")
+	{
+		m_playerId = Identity::Red;
+	}
+	else if (playerInput == "b")
+	{
+		m_playerId = Identity::Black;
+	}
+	else
+	{
+		m_isCanceled = true;
+		m_errorInfo.errorReason = UIText::s_errorCommandComputerReasonInvalidPlayer;
+		return;
+	}
+
+	// Both numbers are optional, but whatever is given has to be a whole, positive number.
+	if (!ParseOptionalPositiveArgument(thinkTimeInput, m_thinkTimeMilliseconds) ||
+		!ParseOptionalPositiveArgument(threadCountInput, m_threadCount))
+	{
+		m_isCanceled = true;
+		m_errorInfo.errorReason = UIText::s_errorCommandReasonInvalidArument;
+	}
+}
+
+bool ComputerOpponentCommand::Execute(Game* game)
+{
+	if (m_thinkTimeMilliseconds > 0)
+	{
+		game->SetComputerThinkTime(std::chrono::milliseconds(m_thinkTimeMilliseconds));
+	}
+
+	if (m_threadCount > 0)
+	{
+		game->SetComputerThreadCount(m_threadCount);
+	}
+
+	game->ToggleComputerControlled(m_playerId);
+	return true;
+}
+
+void ComputerOpponentCommand::Cancel()
+{
+	m_isCanceled = true;
+}
+
+const CommandErrorInfo& ComputerOpponentCommand::GetErrorInfo()
+{
+	return m_errorInfo;
+}
+
+//--------------------------------------------------------------
+
+PerftCommand::~PerftCommand() = default;
+
+PerftCommand::PerftCommand(const std::string& depthInput, const std::string& threadCountInput,
+	const std::string& hashMegabytesInput)
+{
+	if (depthInput.empty() ||
+		!ParseOptionalPositiveArgument(depthInput, m_depth) ||
+		!ParseOptionalPositiveArgument(threadCountInput, m_threadCount) ||
+		!ParseOptionalPositiveArgument(hashMegabytesInput, m_hashMegabytes))
+	{
+		m_isCanceled = true;
+		m_errorInfo.errorReason = UIText::s_errorCommandReasonInvalidArument;
+	}
+}
+
+bool PerftCommand::Execute(Game* game)
+{
+	const int32_t threadCount = m_threadCount > 0 ?
+		m_threadCount :
+		static_cast<int32_t>(std::thread::hardware_concurrency());
+
+	game->RunPerft(m_depth, threadCount, static_cast<size_t>(m_hashMegabytes));
+	return true;
+}
+
+void PerftCommand::Cancel()
+{
+	m_isCanceled = true;
+}
+
+const CommandErrorInfo& PerftCommand::GetErrorInfo()
+{
+	return m_errorInfo;
+}
+
 //===============================================================
 
 }
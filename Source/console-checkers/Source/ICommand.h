@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "GameTypes.h"
+#include "checkers-core/GameTypes.h"
 
 #include <string>
 
@@ -170,6 +170,100 @@ private:
 	CommandErrorInfo m_errorInfo;
 };
 
+//---------------------------------------------------------------
+
+class ComputerOpponentCommand : public ICommand {
+public:
+
+	struct Settings
+	{
+		static constexpr int32_t s_playerArgPosition = 0;
+		static constexpr int32_t s_thinkTimeArgPosition = 1;
+		static constexpr int32_t s_threadCountArgPosition = 2;
+		static constexpr int32_t s_requiredArgumentCount = 1;
+		static constexpr int32_t s_maxArgumentCount = 3;
+	};
+
+	ComputerOpponentCommand(const ComputerOpponentCommand& other) = delete;
+	ComputerOpponentCommand& operator=(const ComputerOpponentCommand& other) = delete;
+	ComputerOpponentCommand(ComputerOpponentCommand&& other) noexcept = default;
+	ComputerOpponentCommand& operator=(ComputerOpponentCommand&& other) noexcept = default;
+
+	// The think time and thread count are optional, leave them empty to keep whatever the computer is using now.
+	ComputerOpponentCommand(const std::string& playerInput, const std::string& thinkTimeInput,
+		const std::string& threadCountInput);
+	virtual ~ComputerOpponentCommand() override;
+
+	// ICommandImpl
+	bool Execute(Game* game) override;
+	void Cancel() override;
+	bool IsCanceled() const override { return m_isCanceled; }
+	const CommandErrorInfo& GetErrorInfo() override;
+
+private:
+	// The player the computer will take over, or hand back.
+	Identity m_playerId = Identity::Neutral;
+
+	// How long the computer may think per turn, in milliseconds. Zero means leave it as is.
+	int32_t m_thinkTimeMilliseconds = 0;
+
+	// How many threads the computer searches with. Zero means leave it as is.
+	int32_t m_threadCount = 0;
+
+	// Various errors can cause us to cancel this command.
+	bool m_isCanceled = false;
+
+	// As much context as we can have around any errors that happen.
+	CommandErrorInfo m_errorInfo;
+};
+
+//---------------------------------------------------------------
+
+class PerftCommand : public ICommand {
+public:
+
+	struct Settings
+	{
+		static constexpr int32_t s_depthArgPosition = 0;
+		static constexpr int32_t s_threadCountArgPosition = 1;
+		static constexpr int32_t s_hashMegabytesArgPosition = 2;
+		static constexpr int32_t s_requiredArgumentCount = 1;
+		static constexpr int32_t s_maxArgumentCount = 3;
+	};
+
+	PerftCommand(const PerftCommand& other) = delete;
+	PerftCommand& operator=(const PerftCommand& other) = delete;
+	PerftCommand(PerftCommand&& other) noexcept = default;
+	PerftCommand& operator=(PerftCommand&& other) noexcept = default;
+
+	// The thread count and hash size are optional. Leave them empty to use every core and no hash.
+	PerftCommand(const std::string& depthInput, const std::string& threadCountInput,
+		const std::string& hashMegabytesInput);
+	virtual ~PerftCommand() override;
+
+	// ICommandImpl
+	bool Execute(Game* game) override;
+	void Cancel() override;
+	bool IsCanceled() const override { return m_isCanceled; }
+	const CommandErrorInfo& GetErrorInfo() override;
+
+private:
+	// How many turns ahead to count.
+	int32_t m_depth = 0;
+
+	// Threads to count with. Zero means every core.
+	int32_t m_threadCount = 0;
+
+	// Size of the perft hash table. Zero means no hash.
+	int32_t m_hashMegabytes = 0;
+
+	// Various errors can cause us to cancel this command.
+	bool m_isCanceled = false;
+
+	// As much context as we can have around any errors that happen.
+	CommandErrorInfo m_errorInfo;
+};
+
 //===============================================================
 
 }
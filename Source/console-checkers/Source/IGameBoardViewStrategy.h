@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "GameTypes.h"
+#include "checkers-core/GameTypes.h"
 
 #include <string>
 
@@ -1,21 +1,42 @@
 #include "ConsoleGameDisplay.h"
 #include "Game.h"
-#include "GameState.h"
+
+#include "checkers-core/AsyncFileLogSink.h"
+#include "checkers-core/GameSettings.h"
+#include "checkers-core/GameState.h"
 
 #include <spdlog/spdlog-inl.h>
+#ifdef _WIN32
 #include <spdlog/sinks/msvc_sink.h>
+#else
+#include <spdlog/sinks/null_sink.h>
+#endif
 
 void SetupLogger() {
 
+#ifdef _WIN32
 	// The console should be used for our game UI, so send logs to the VS Console Window.
 	// We could write to file but we just want to use logs for debugging, the game won't ship with logging.
-	auto vs_sink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
-	auto logger = std::make_shared<spdlog::logger>("checkers_logger", vs_sink);
+	auto sink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
+#else
+	// The console should be used for our game UI, so logs go to a file. A background thread does the writing, so
+	// logging never holds up a move.
+	auto fileSink = std::make_shared<Checkers::AsyncFileLogSink>(
+		Checkers::LogSettings::s_logFilePath, Checkers::LogSettings::s_maxLogFileBytes, Checkers::LogSettings::s_maxLogFileCount);
+	std::shared_ptr<spdlog::sinks::sink> sink = fileSink;
+	if (!fileSink->Initialize())
+	{
+		// Logs are only for debugging, the game plays fine without them.
+		sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+	}
+#endif
+	auto logger = std::make_shared<spdlog::logger>("checkers_logger", sink);
 	spdlog::set_default_logger(logger);
 	spdlog::set_level(spdlog::level::debug);
 }
 
 void EnableANSI() {
+#ifdef _WIN32
 	HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
 	if (hOut == INVALID_HANDLE_VALUE)
 		return;
@@ -26,6 +47,7 @@ void EnableANSI() {
 
 	dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
 	SetConsoleMode(hOut, dwMode);
+#endif
 }
 
 int main()
@@ -43,5 +65,8 @@ int main()
 	// Run until we're done.
 	game.Run();
 
+	// Drops the logger, which has the async sink write out whatever it still has buffered.
+	spdlog::shutdown();
+
 	return 0;
 }